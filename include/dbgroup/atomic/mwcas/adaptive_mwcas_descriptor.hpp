@@ -0,0 +1,327 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_ADAPTIVE_MWCAS_DESCRIPTOR_HPP_
+#define DBGROUP_ATOMIC_MWCAS_ADAPTIVE_MWCAS_DESCRIPTOR_HPP_
+
+// C++ standard libraries
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// external C++ libraries
+#include <dbgroup/memory/utility.hpp>
+#include <dbgroup/thread/epoch_guard.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/lock_free/aopt_descriptor.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas
+{
+/**
+ * @brief A class to manage a MwCAS operation that switches algorithms at runtime.
+ *
+ * Each MwCAS is performed by the deadlock-free algorithm or AOPT according to
+ * the current mode. Both algorithms use the same word format, so the mode can be
+ * changed while other threads are performing MwCAS. The mode is switched to the
+ * lock-free one when threads often wait for stalled descriptors, and it returns
+ * to the deadlock-free one periodically to check whether the stalls have gone.
+ * It also returns early if MwCAS fails more often in the lock-free mode than in
+ * the deadlock-free one just before switching.
+ *
+ * @note This descriptor is used as a stack object, but `Read` and `MwCAS` must be
+ * called in the scope of `CreateEpochGuard` because they may refer to AOPT
+ * descriptors.
+ */
+class alignas(kCacheLineSize) AdaptiveMwCASDescriptor
+{
+ public:
+  /*##########################################################################*
+   * Public types
+   *##########################################################################*/
+
+  /**
+   * @brief An enumeration for representing MwCAS algorithms.
+   *
+   */
+  enum Mode : uint64_t {
+    kDeadlockFree = 0,
+    kLockFree,
+  };
+
+  /*##########################################################################*
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct an empty descriptor for MwCAS operations.
+   *
+   */
+  constexpr AdaptiveMwCASDescriptor() = default;
+
+  constexpr AdaptiveMwCASDescriptor(const AdaptiveMwCASDescriptor&) = default;
+  constexpr AdaptiveMwCASDescriptor(AdaptiveMwCASDescriptor&&) noexcept = default;
+
+  constexpr auto operator=(const AdaptiveMwCASDescriptor& obj)
+      -> AdaptiveMwCASDescriptor& = default;
+  constexpr auto operator=(AdaptiveMwCASDescriptor&&) noexcept
+      -> AdaptiveMwCASDescriptor& = default;
+
+  /*##########################################################################*
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the AdaptiveMwCASDescriptor object.
+   *
+   */
+  ~AdaptiveMwCASDescriptor() = default;
+
+  /*##########################################################################*
+   * Public getters/setters
+   *##########################################################################*/
+
+  /**
+   * @return The number of registered MwCAS targets.
+   */
+  [[nodiscard]]
+  constexpr auto
+  Size() const  //
+      -> size_t
+  {
+    return target_cnt_;
+  }
+
+  /**
+   * @return The current mode of MwCAS.
+   */
+  [[nodiscard]]
+  static auto
+  GetMode()  //
+      -> Mode
+  {
+    return _mode.load(kRelaxed);
+  }
+
+  /**
+   * @brief Switch the mode of MwCAS manually.
+   *
+   * @param mode A new mode of MwCAS.
+   * @note The mode may be switched again according to the statistics of stalls.
+   */
+  static void
+  SetMode(  //
+      const Mode mode)
+  {
+    _mode.store(mode, kRelaxed);
+    _window_cnt.store(0, kRelaxed);
+  }
+
+  /*##########################################################################*
+   * Public APIs for managing memory
+   *##########################################################################*/
+
+  /**
+   * @brief Start garbage collection for lock-free descriptors.
+   *
+   * @param gc_interval Interval for GC in microseconds.
+   * @param gc_thread_num The number of worker threads to release garbages.
+   * @param reserved_num The number of descriptors to be pre-allocated.
+   * @note This function must be called before performing MwCAS.
+   */
+  static void StartGC(  //
+      size_t gc_interval = ::dbgroup::memory::kDefaultGCTime,
+      size_t gc_thread_num = ::dbgroup::memory::kDefaultGCThreadNum,
+      size_t reserved_num = kDefaultReservedDescNum);
+
+  /**
+   * @brief Stop garbage collection for lock-free descriptors.
+   *
+   */
+  static void StopGC();
+
+  /**
+   * @return A guard instance for preventing GC.
+   */
+  static auto CreateEpochGuard()  //
+      -> ::dbgroup::thread::EpochGuard;
+
+  /*##########################################################################*
+   * Public utility functions
+   *##########################################################################*/
+
+  /**
+   * @brief Read a value from a given memory address.
+   *
+   * @tparam T An expected class of a target field.
+   * @param addr A target memory address to read.
+   * @param fence A flag for controling std::memory_order.
+   * @return A read value.
+   * @note If a memory address is included in MwCAS target fields, it must be
+   * read via this function.
+   */
+  template <class T>
+  static auto
+  Read(  //
+      const void* const addr,
+      const std::memory_order fence = std::memory_order_seq_cst)  //
+      -> T
+  {
+    return lock_free::AOPTDescriptor::Read<T>(addr, fence);
+  }
+
+  /**
+   * @brief Read values from given memory addresses at once.
+   *
+   * @tparam T An expected class of target fields.
+   * @param addrs Target memory addresses to read.
+   * @param[out] vals A buffer to store read values.
+   * @param num The number of target addresses.
+   * @param fence A flag for controling std::memory_order.
+   */
+  template <class T>
+  static void
+  ReadBatch(  //
+      const void* const* addrs,
+      T* vals,
+      const size_t num,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    lock_free::AOPTDescriptor::ReadBatch<T>(addrs, vals, num, fence);
+  }
+
+  /**
+   * @brief Add a new MwCAS target to this descriptor.
+   *
+   * @tparam T The class of a target word.
+   * @param addr A target memory address.
+   * @param old_val The expected value of a target field.
+   * @param new_val An inserting value into a target field.
+   * @param fence A flag for controling std::memory_order.
+   */
+  template <class T>
+  constexpr void
+  AddMwCASTarget(  //
+      void* const addr,
+      const T old_val,
+      const T new_val,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    static_assert(CanMwCAS<T>());
+    if constexpr (kPrefetchTargets) {
+      PrefetchForWrite(addr);
+    }
+
+    targets_.at(target_cnt_++) = MwCASTarget{
+        addr,
+        std::bit_cast<uint64_t>(old_val),
+        std::bit_cast<uint64_t>(new_val),
+        fence,
+    };
+  }
+
+  /**
+   * @brief Perform a MwCAS operation by using registered targets.
+   *
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto MwCAS()  //
+      -> bool;
+
+ private:
+  /*##########################################################################*
+   * Internal types
+   *##########################################################################*/
+
+  /**
+   * @brief A class for representing MwCAS targets.
+   *
+   */
+  struct MwCASTarget {
+    /// @brief A target memory address.
+    void* addr;
+
+    /// @brief An expected value of a target field.
+    uint64_t old_val;
+
+    /// @brief An inserting value into a target field.
+    uint64_t new_val;
+
+    /// @brief A fence to be inserted when embedding a new value.
+    std::memory_order fence;
+  };
+
+  /*##########################################################################*
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The number of MwCAS operations in each thread to check statistics.
+  static constexpr size_t kWindowSize = 1024;
+
+  /// @brief Switch to the lock-free mode if stalls exceed 1/N of MwCAS.
+  static constexpr size_t kStallRatio = 64;
+
+  /// @brief The minimum number of windows in the lock-free mode.
+  static constexpr size_t kMinProbation = 16;
+
+  /// @brief The maximum number of windows in the lock-free mode.
+  static constexpr size_t kMaxProbation = 4096;
+
+  /*##########################################################################*
+   * Internal utility functions
+   *##########################################################################*/
+
+  /**
+   * @brief Switch the mode if needed after each thread performs a window of
+   * MwCAS operations.
+   *
+   * @param mode The mode used for the last MwCAS.
+   * @param succeeded Whether the last MwCAS succeeded.
+   */
+  static void UpdateMode(  //
+      Mode mode,
+      bool succeeded);
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The number of registered MwCAS targets.
+  size_t target_cnt_{};
+
+  /// @brief Target entries of MwCAS.
+  std::array<MwCASTarget, kMwCASCapacity> targets_ = {};
+
+  /// @brief The current mode of MwCAS.
+  static inline std::atomic<Mode> _mode{kDeadlockFree};  // NOLINT
+
+  /// @brief The number of windows performed in the current mode.
+  static inline std::atomic_size_t _window_cnt{0};  // NOLINT
+
+  /// @brief The number of windows to stay in the lock-free mode.
+  static inline std::atomic_size_t _probation{kMinProbation};  // NOLINT
+
+  /// @brief The number of failed MwCAS in the window before switching modes.
+  static inline std::atomic_size_t _fail_num{0};  // NOLINT
+};
+
+}  // namespace dbgroup::atomic::mwcas
+
+#endif  // DBGROUP_ATOMIC_MWCAS_ADAPTIVE_MWCAS_DESCRIPTOR_HPP_
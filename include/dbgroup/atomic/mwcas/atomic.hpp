@@ -0,0 +1,265 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_ATOMIC_HPP_
+#define DBGROUP_ATOMIC_MWCAS_ATOMIC_HPP_
+
+// C++ standard libraries
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// local sources
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas
+{
+/*############################################################################*
+ * Padding policies
+ *############################################################################*/
+
+/**
+ * @brief A padding policy for placing fields densely.
+ *
+ */
+struct NoPadding {
+  /// @brief The minimum alignment of a field.
+  static constexpr size_t kAlignment = 1;
+};
+
+/**
+ * @brief A padding policy for placing each field in its own cache line.
+ *
+ * This prevents false sharing between hot fields updated by different threads.
+ */
+struct CacheLinePadding {
+  /// @brief The minimum alignment of a field.
+  static constexpr size_t kAlignment = kCacheLineSize;
+};
+
+/*############################################################################*
+ * Type traits
+ *############################################################################*/
+
+/**
+ * @brief A class for extracting the class of target words of a descriptor.
+ *
+ * @tparam Descriptor A target descriptor class.
+ */
+template <class Descriptor>
+struct TargetWord {
+  /// @brief Target words are 8-byte integers by default.
+  using Type = uint64_t;
+};
+
+/**
+ * @brief A specialization for descriptors with their own word classes.
+ *
+ * @tparam Descriptor A target descriptor class with `Descriptor::Word`.
+ */
+template <class Descriptor>
+  requires requires { typename Descriptor::Word; }
+struct TargetWord<Descriptor> {
+  /// @brief Target words are given by the descriptor (e.g., 16-byte words).
+  using Type = typename Descriptor::Word;
+};
+
+/*############################################################################*
+ * Typed fields
+ *############################################################################*/
+
+/**
+ * @brief A class for representing a MwCAS target field of a given class.
+ *
+ * This class fixes how a field is read (i.e., via `Descriptor::Read`) at compile
+ * time, so its value cannot be read by plain loads by mistake. All the member
+ * functions are inlined into calls of `Descriptor`, so they cost the same as
+ * hand-written ones.
+ *
+ * @tparam T The class of a target value.
+ * @tparam Descriptor A MwCAS descriptor class for updating this field.
+ * @tparam Padding A padding policy (e.g., `CacheLinePadding`).
+ */
+template <class T, class Descriptor, class Padding = NoPadding>
+class alignas(std::max(Padding::kAlignment, alignof(typename TargetWord<Descriptor>::Type)))
+    Atomic
+{
+ public:
+  /*##########################################################################*
+   * Public types
+   *##########################################################################*/
+
+  /// @brief The class of an actual word in memory.
+  using Word = typename TargetWord<Descriptor>::Type;
+
+  /// @brief The class of values returned by `Descriptor::Read`.
+  using ReadResult = decltype(Descriptor::template Read<T>(std::declval<Word*>()));
+
+  /// @brief A flag for indicating `Descriptor::Read` also returns expected words.
+  static constexpr bool kHasExpectedWord = !std::is_same_v<ReadResult, T>;
+
+  /// @brief The class of expected values given to `AddMwCASTarget`.
+  ///
+  /// For the lock-free MwCAS, this is a word with its version for preventing ABA
+  /// problems. Otherwise, this is the same as `T`.
+  using Expected = std::tuple_element_t<  //
+      1,
+      std::conditional_t<kHasExpectedWord, ReadResult, std::pair<T, T>>>;
+
+  /*##########################################################################*
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a field with zero.
+   *
+   */
+  constexpr Atomic() = default;
+
+  /**
+   * @brief Construct a field with a given value.
+   *
+   * @param val An initial value.
+   */
+  explicit constexpr Atomic(  //
+      const T val)
+      : word_{ToWord(val)}
+  {
+  }
+
+  Atomic(const Atomic&) = delete;
+  Atomic(Atomic&&) = delete;
+
+  auto operator=(const Atomic& obj) -> Atomic& = delete;
+  auto operator=(Atomic&&) -> Atomic& = delete;
+
+  /*##########################################################################*
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the Atomic object.
+   *
+   */
+  ~Atomic() = default;
+
+  /*##########################################################################*
+   * Public utility functions
+   *##########################################################################*/
+
+  /**
+   * @param fence A flag for controling std::memory_order.
+   * @return The current value of this field.
+   */
+  [[nodiscard]]
+  auto
+  Load(  //
+      const std::memory_order fence = std::memory_order_seq_cst) const  //
+      -> T
+  {
+    if constexpr (kHasExpectedWord) {
+      return Descriptor::template Read<T>(GetAddr(), fence).first;
+    } else {
+      return Descriptor::template Read<T>(GetAddr(), fence);
+    }
+  }
+
+  /**
+   * @param fence A flag for controling std::memory_order.
+   * @return The pair of the current value and an expected value for MwCAS.
+   * @note Use the expected value as is for `AddMwCASTarget` instead of reading
+   * this field again.
+   */
+  [[nodiscard]]
+  auto
+  LoadForMwCAS(  //
+      const std::memory_order fence = std::memory_order_seq_cst) const  //
+      -> std::pair<T, Expected>
+  {
+    if constexpr (kHasExpectedWord) {
+      return Descriptor::template Read<T>(GetAddr(), fence);
+    } else {
+      const auto val = Descriptor::template Read<T>(GetAddr(), fence);
+      return std::pair{val, val};
+    }
+  }
+
+  /**
+   * @brief Add this field to a given descriptor as a MwCAS target.
+   *
+   * @param desc A descriptor for performing MwCAS.
+   * @param expected An expected value given by `LoadForMwCAS`.
+   * @param desired A desired value of this field.
+   * @param fence A flag for controling std::memory_order.
+   */
+  void
+  AddMwCASTarget(  //
+      Descriptor& desc,
+      const Expected expected,
+      const T desired,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    desc.AddMwCASTarget(&word_, expected, desired, fence);
+  }
+
+ private:
+  /*##########################################################################*
+   * Internal utility functions
+   *##########################################################################*/
+
+  /**
+   * @param val A target value.
+   * @return A word representing the given value.
+   */
+  static constexpr auto
+  ToWord(  //
+      const T val)  //
+      -> Word
+  {
+    if constexpr (std::is_same_v<Word, uint64_t>) {
+      return std::bit_cast<uint64_t>(val);
+    } else {
+      return Word{std::bit_cast<uint64_t>(val)};  // the other bits are metadata
+    }
+  }
+
+  /**
+   * @return The address of this field for descriptors.
+   * @note Some descriptors take non-const addresses even for reading.
+   */
+  [[nodiscard]]
+  auto
+  GetAddr() const  //
+      -> Word*
+  {
+    return const_cast<Word*>(&word_);  // NOLINT
+  }
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief An actual word in memory.
+  Word word_{};
+};
+
+}  // namespace dbgroup::atomic::mwcas
+
+#endif  // DBGROUP_ATOMIC_MWCAS_ATOMIC_HPP_
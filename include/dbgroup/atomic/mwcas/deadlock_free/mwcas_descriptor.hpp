@@ -23,7 +23,10 @@
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <optional>
 #include <thread>
+#include <type_traits>
 
 // external C++ libraries
 #include <dbgroup/lock/utility.hpp>
@@ -36,6 +39,10 @@ namespace dbgroup::atomic::mwcas::deadlock_free
 /**
  * @brief A class to manage a MwCAS (multi-words compare-and-swap) operation.
  *
+ * Targets are kept sorted by their addresses when they are added, so every
+ * thread embeds descriptors in the same order regardless of the order of
+ * `AddMwCASTarget` calls. Targets with the same address are merged into one
+ * entry; if their expected or new bits conflict, MwCAS always fails.
  */
 class alignas(kCacheLineSize) MwCASDescriptor
 {
@@ -71,7 +78,8 @@ class alignas(kCacheLineSize) MwCASDescriptor
    *##########################################################################*/
 
   /**
-   * @return The number of registered MwCAS targets.
+   * @return The number of registered MwCAS targets (merged targets are counted
+   * once).
    */
   [[nodiscard]]
   constexpr auto
@@ -81,6 +89,35 @@ class alignas(kCacheLineSize) MwCASDescriptor
     return target_cnt_;
   }
 
+  /**
+   * @return The number of times that this thread has waited for descriptors of
+   * other threads beyond the retry threshold.
+   * @note This counter indicates that other threads were stalled (e.g.,
+   * preempted) while their descriptors were embedded.
+   */
+  [[nodiscard]]
+  static auto
+  GetStallCount()  //
+      -> size_t
+  {
+    return _stall_cnt;
+  }
+
+  /**
+   * @return The number of times that this thread has rolled back MwCAS because
+   * it was preempted (i.e., migrated to another CPU or involuntarily switched
+   * out on the same CPU) while embedding descriptors.
+   * @note This counter is always zero without `MWCAS_DETECT_PREEMPTION` or on
+   * platforms other than Linux.
+   */
+  [[nodiscard]]
+  static auto
+  GetRollbackCount()  //
+      -> size_t
+  {
+    return _rollback_cnt;
+  }
+
   /*##########################################################################*
    * Public utility functions
    *##########################################################################*/
@@ -101,20 +138,64 @@ class alignas(kCacheLineSize) MwCASDescriptor
       const void* const addr,
       const std::memory_order fence = std::memory_order_seq_cst)  //
       -> T
+  {
+    while (true) {
+      if (const auto val = TryRead<T>(addr, fence); val) return *val;
+      std::this_thread::sleep_for(kBackOffTime);
+    }
+  }
+
+  /**
+   * @brief Read a value from a given memory address without sleeping.
+   *
+   * @tparam T An expected class of a target field.
+   * @param addr A target memory address to read.
+   * @param fence A flag for controling std::memory_order.
+   * @return A read value if any.
+   * @retval std::nullopt if a descriptor remains embedded beyond the retry
+   * threshold. In this case, callers should back off (e.g., yield to other
+   * tasks) and retry.
+   */
+  template <class T>
+  static auto
+  TryRead(  //
+      const void* const addr,
+      const std::memory_order fence = std::memory_order_seq_cst)  //
+      -> std::optional<T>
   {
     static_assert(CanMwCAS<T>());
 
     const auto* const target_addr = static_cast<const std::atomic_uint64_t*>(addr);
-    uint64_t word{};
-    while (true) {
-      for (size_t i = 1; true; ++i) {
-        word = target_addr->load(fence);
-        if ((word & kMwCASFlag) == 0) return std::bit_cast<T>(word);
-        if (i > kRetryNum) break;
-        CPP_UTILITY_SPINLOCK_HINT
-      }
-      std::this_thread::sleep_for(kBackOffTime);
+    for (size_t i = 1; true; ++i) {
+      const auto word = target_addr->load(fence);
+      if ((word & kMwCASFlag) == 0) return std::bit_cast<T>(word);
+      if (i > kRetryNum) break;
+      CPP_UTILITY_SPINLOCK_HINT
     }
+    ++_stall_cnt;
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Read values from given memory addresses at once.
+   *
+   * @tparam T An expected class of target fields.
+   * @param addrs Target memory addresses to read.
+   * @param[out] vals A buffer to store read values.
+   * @param num The number of target addresses.
+   * @param fence A flag for controling std::memory_order.
+   * @note This function prefetches all the addresses before reading them so
+   * that their cache misses overlap.
+   */
+  template <class T>
+  static void
+  ReadBatch(  //
+      const void* const* addrs,
+      T* vals,
+      const size_t num,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    BatchRead(addrs, vals, num, [fence](const void* addr) { return Read<T>(addr, fence); });
   }
 
   /**
@@ -135,69 +216,245 @@ class alignas(kCacheLineSize) MwCASDescriptor
       const std::memory_order fence = std::memory_order_seq_cst)
   {
     static_assert(CanMwCAS<T>());
+    if constexpr (kPrefetchTargets) {
+      PrefetchForWrite(addr);
+    }
+
+    AddTarget(static_cast<std::atomic_uint64_t*>(addr), ~0UL, std::bit_cast<uint64_t>(old_val),
+              std::bit_cast<uint64_t>(new_val), 0, fence);
+  }
+
+  /**
+   * @brief Add a new MwCAS target that compares and swaps only masked bits.
+   *
+   * The unmasked bits of a target word may be modified by other threads until
+   * this MwCAS embeds its descriptor, and they are preserved when the MwCAS
+   * completes.
+   *
+   * @tparam T The class of a target word.
+   * @param addr A target memory address.
+   * @param mask A bitmask for selecting target bits.
+   * @param expected_bits The expected bits of a target field.
+   * @param new_bits Inserting bits into a target field.
+   * @param fence A flag for controling std::memory_order.
+   * @note The bits out of a given mask in `expected_bits` and `new_bits` are
+   * ignored.
+   */
+  template <class T>
+  constexpr void
+  AddMaskedTarget(  //
+      void* const addr,
+      const T mask,
+      const T expected_bits,
+      const T new_bits,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    static_assert(CanMwCAS<T>());
+    if constexpr (kPrefetchTargets) {
+      PrefetchForWrite(addr);
+    }
+
+    const auto bit_mask = std::bit_cast<uint64_t>(mask) & ~kMwCASFlag;
+    AddTarget(static_cast<std::atomic_uint64_t*>(addr), bit_mask,
+              std::bit_cast<uint64_t>(expected_bits) & bit_mask,
+              std::bit_cast<uint64_t>(new_bits) & bit_mask, 0, fence);
+  }
+
+  /**
+   * @brief Add a new MwCAS target that adds a delta to an integer field.
+   *
+   * This target never makes MwCAS fail because it does not expect any value. A
+   * new value is computed from the value replaced with a descriptor, so
+   * concurrent increments by other threads are not lost.
+   *
+   * @tparam T The class of a target integer.
+   * @param addr A target memory address.
+   * @param delta A value to be added (or subtracted if negative).
+   * @param fence A flag for controling std::memory_order.
+   * @note If a new value overflows into the MwCAS flag (i.e., the most
+   * significant bit) or becomes negative, MwCAS fails without any modification.
+   */
+  template <class T>
+  constexpr void
+  AddDeltaTarget(  //
+      void* const addr,
+      const T delta,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    static_assert(std::is_integral_v<T> && sizeof(T) == sizeof(uint64_t));
+    if constexpr (kPrefetchTargets) {
+      PrefetchForWrite(addr);
+    }
 
-    targets_.at(target_cnt_++) =
-        MwCASTarget{static_cast<std::atomic_uint64_t*>(addr), old_val, new_val, fence};
+    AddTarget(static_cast<std::atomic_uint64_t*>(addr), 0, 0, 0, static_cast<uint64_t>(delta),
+              fence);
   }
 
   /**
    * @brief Perform a MwCAS operation by using registered targets.
    *
    * @retval true if a MwCAS operation succeeds.
-   * @retval false otherwise.
+   * @retval false otherwise (including conflicting targets with one address and
+   * new values overflowing into the MwCAS flag).
    */
   auto MwCAS()  //
       -> bool;
 
  private:
   /*##########################################################################*
-   * Internal types
+   * Internal APIs
    *##########################################################################*/
 
   /**
-   * @brief A class for representing MwCAS targets.
+   * @brief Insert a target into the address order or merge it with a registered
+   * target with the same address.
+   *
+   * Merged targets compare and swap the union of their masks or add the sum of
+   * their deltas. If the overlapped bits of their expected or new values differ,
+   * or if a delta target is merged with a compared one, this descriptor is
+   * marked as conflicted.
    *
+   * @param addr A target memory address.
+   * @param mask A bitmask for selecting target bits.
+   * @param old_bits The expected bits of a target field.
+   * @param new_bits Inserting bits into a target field.
+   * @param delta A value to be added.
+   * @param fence A flag for controling std::memory_order.
    */
-  struct MwCASTarget {
-    /// @brief A target memory address.
-    std::atomic_uint64_t* addr;
+  constexpr void
+  AddTarget(  //
+      std::atomic_uint64_t* const addr,
+      const uint64_t mask,
+      const uint64_t old_bits,
+      const uint64_t new_bits,
+      const uint64_t delta,
+      const std::memory_order fence)
+  {
+    auto pos = target_cnt_;
+    while (pos > 0 && std::less{}(addr, addrs_[pos - 1])) {
+      --pos;
+    }
 
-    /// @brief An expected value of a target field.
-    uint64_t old_val;
+    if (pos > 0 && addrs_[pos - 1] == addr) {
+      const auto i = pos - 1;
+      const auto overlap = masks_[i] & mask;
+      if ((masks_[i] == 0) != (mask == 0)  // a delta cannot be mixed with a new value
+          || ((old_vals_[i] ^ old_bits) & overlap) != 0
+          || ((new_vals_[i] ^ new_bits) & overlap) != 0) {
+        has_conflict_ = true;
+        return;
+      }
+      old_vals_[i] = (old_vals_[i] & masks_[i]) | old_bits;
+      new_vals_[i] = (new_vals_[i] & masks_[i]) | new_bits;
+      masks_[i] |= mask;
+      deltas_[i] += delta;
+      if (fences_[i] != fence) {
+        fences_[i] = std::memory_order_seq_cst;
+      }
+      return;
+    }
 
-    /// @brief An inserting value into a target field.
-    uint64_t new_val;
+    static_cast<void>(addrs_.at(target_cnt_));  // check the capacity
+    for (auto i = target_cnt_; i > pos; --i) {
+      addrs_[i] = addrs_[i - 1];
+      old_vals_[i] = old_vals_[i - 1];
+      new_vals_[i] = new_vals_[i - 1];
+      masks_[i] = masks_[i - 1];
+      deltas_[i] = deltas_[i - 1];
+      fences_[i] = fences_[i - 1];
+    }
+    addrs_[pos] = addr;
+    old_vals_[pos] = old_bits;
+    new_vals_[pos] = new_bits;
+    masks_[pos] = mask;
+    deltas_[pos] = delta;
+    fences_[pos] = fence;
+    ++target_cnt_;
+  }
 
-    /// @brief A fence to be inserted when embedding a new value.
-    std::memory_order fence;
-  };
+  /**
+   * @param pos The position of a target word.
+   * @param word The current word of the target.
+   * @return A new word that keeps the unmasked bits and adds a delta.
+   */
+  [[nodiscard]]
+  constexpr auto
+  GetNewWord(  //
+      const size_t pos,
+      const uint64_t word) const  //
+      -> uint64_t
+  {
+    const auto mask = masks_[pos];
+    return ((word & ~mask) | (new_vals_[pos] & mask)) + deltas_[pos];
+  }
 
-  /*##########################################################################*
-   * Internal APIs
-   *##########################################################################*/
+  /**
+   * @brief Perform MwCAS by plain loads and stores in the exclusive mode.
+   *
+   * @retval true if all the target words have their expected values.
+   * @retval false otherwise.
+   */
+  auto MwCASExclusively()  //
+      -> bool;
+
+  /**
+   * @retval true if any target word has been modified from its expected value.
+   * @retval false otherwise (i.e., this MwCAS may succeed).
+   * @note This function only reads target words, so it does not invalidate
+   * the cache lines of other threads.
+   */
+  [[nodiscard]]
+  auto HasStaleTarget() const  //
+      -> bool;
 
   /**
    * @brief Embed a descriptor into this target address to linearlize MwCAS.
    *
    * @param desc_addr The address of this descriptor with a MwCAS flag.
    * @param pos The position of a target word.
+   * @param[out] replaced The word replaced with the descriptor.
    * @retval true if the descriptor address is successfully embedded.
    * @retval false otherwise.
    */
   auto EmbedDescriptor(  //
       uint64_t desc_addr,
-      size_t pos)  //
+      size_t pos,
+      uint64_t& replaced)  //
       -> bool;
 
   /*##########################################################################*
    * Internal member variables
    *##########################################################################*/
 
-  /// @brief Target entries of MwCAS.
-  std::array<MwCASTarget, kMwCASCapacity> targets_ = {};
+  /// @brief The expected values of target fields.
+  std::array<uint64_t, kMwCASCapacity> old_vals_ = {};
+
+  /// @brief The inserting values into target fields.
+  std::array<uint64_t, kMwCASCapacity> new_vals_ = {};
+
+  /// @brief Target memory addresses of MwCAS.
+  std::array<std::atomic_uint64_t*, kMwCASCapacity> addrs_ = {};
+
+  /// @brief Bitmasks for selecting compared and swapped bits of target fields.
+  std::array<uint64_t, kMwCASCapacity> masks_ = {};
+
+  /// @brief Deltas to be added to target fields.
+  std::array<uint64_t, kMwCASCapacity> deltas_ = {};
+
+  /// @brief Fences to be inserted when embedding a descriptor.
+  std::array<std::memory_order, kMwCASCapacity> fences_ = {};
 
   /// @brief The number of registered MwCAS targets.
   size_t target_cnt_{};
+
+  /// @brief A flag for indicating targets with one address conflict.
+  bool has_conflict_{false};
+
+  /// @brief The number of stalls observed by this thread.
+  static inline thread_local size_t _stall_cnt{0};  // NOLINT
+
+  /// @brief The number of rollbacks due to preemption in this thread.
+  static inline thread_local size_t _rollback_cnt{0};  // NOLINT
 };
 
 }  // namespace dbgroup::atomic::mwcas::deadlock_free
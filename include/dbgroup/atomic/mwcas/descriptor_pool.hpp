@@ -0,0 +1,464 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_DESCRIPTOR_POOL_HPP_
+#define DBGROUP_ATOMIC_MWCAS_DESCRIPTOR_POOL_HPP_
+
+// C++ standard libraries
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// system libraries
+#include <sys/mman.h>
+
+// external C++ libraries
+#include <dbgroup/memory/epoch_based_gc.hpp>
+#include <dbgroup/thread/epoch_guard.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas
+{
+/**
+ * @brief A slab arena and an epoch-based GC for MwCAS descriptors.
+ *
+ * Descriptors are carved from cache-line-aligned chunks of `kDescChunkSize`
+ * bytes so that they are placed densely, and chunks are advised to be backed by
+ * huge pages if `MWCAS_USE_HUGE_PAGES` is defined. Retired descriptors are
+ * handed to the GC in batches, and the GC returns them to this arena instead of
+ * releasing them. Thus, the memory of descriptors is never passed to `malloc`
+ * and `free` once it has been reserved.
+ *
+ * If `MWCAS_USE_DESCRIPTOR_TABLE` is defined and a descriptor class can be
+ * constructed from an index, each descriptor is constructed with its index
+ * (i.e., the pair of a chunk ID and a slot in the chunk), and chunks are
+ * registered with a table so that descriptors can be found by their indices.
+ *
+ * @tparam Descriptor A target descriptor class.
+ * @note Each descriptor class must have only one pool (i.e., the member
+ * functions of this class are all static).
+ */
+template <class Descriptor>
+class DescriptorPool
+{
+ public:
+  /*##########################################################################*
+   * Public constants
+   *##########################################################################*/
+
+  /// @brief The number of descriptors in one chunk.
+  static constexpr size_t kDescNumInChunk = kDescChunkSize / sizeof(Descriptor);
+
+  /// @brief The number of bits for representing slots in a chunk.
+  static constexpr size_t kSlotBitNum = std::bit_width(kDescNumInChunk - 1);
+
+  /// @brief The maximum number of chunks registered with a descriptor table.
+  static constexpr size_t kMaxChunkNum = 4096;
+
+  /// @brief The number of bits for representing descriptor indices.
+  static constexpr size_t kIndexBitNum = kSlotBitNum + std::bit_width(kMaxChunkNum - 1);
+
+  /*##########################################################################*
+   * Public APIs for managing memory
+   *##########################################################################*/
+
+  /**
+   * @brief Start garbage collection and reserve descriptors.
+   *
+   * @param gc_interval Interval for GC in microseconds.
+   * @param gc_thread_num The number of worker threads to release garbages.
+   * @param reserved_num The number of descriptors to be pre-allocated.
+   */
+  static void
+  StartGC(  //
+      const size_t gc_interval,
+      const size_t gc_thread_num,
+      const size_t reserved_num)
+  {
+    {
+      const std::lock_guard lock{_arena.mtx};
+      _arena.Reserve(reserved_num);
+    }
+    _arena.gc = std::make_unique<EpochBasedGC>(gc_interval, gc_thread_num, kBatchSize);
+  }
+
+  /**
+   * @brief Stop garbage collection.
+   *
+   * @note Retired descriptors are returned to the arena by this function.
+   */
+  static void
+  StopGC()
+  {
+    _arena.gc.reset();
+  }
+
+  /**
+   * @return A guard instance for preventing GC.
+   */
+  static auto
+  CreateEpochGuard()  //
+      -> ::dbgroup::thread::EpochGuard
+  {
+    return _arena.gc->CreateEpochGuard();
+  }
+
+  /**
+   * @return A descriptor that is not referred by any other threads.
+   */
+  static auto
+  Get()  //
+      -> Descriptor*
+  {
+    auto& cache = _cache;
+    if (cache.free_num == 0) {
+      const std::lock_guard lock{_arena.mtx};
+      cache.free_num = _arena.Pop(cache.free.data(), kBatchSize);
+    }
+    return cache.free[--cache.free_num];
+  }
+
+  /**
+   * @param index The index of a descriptor in the descriptor table.
+   * @return The descriptor with the given index.
+   */
+  static auto
+  GetByIndex(  //
+      const uint64_t index)  //
+      -> Descriptor*
+  {
+    auto* const head = _table[index >> kSlotBitNum].load(std::memory_order_acquire);
+    return head + (index & ((1UL << kSlotBitNum) - 1UL));
+  }
+
+  /**
+   * @brief Reuse a given descriptor immediately.
+   *
+   * @param desc A descriptor that has never been published to other threads.
+   */
+  static void
+  Recycle(  //
+      Descriptor* const desc)
+  {
+    auto& cache = _cache;
+    if (cache.free_num >= kCacheCapacity) {
+      // move the older half of cached descriptors to the arena
+      const std::lock_guard lock{_arena.mtx};
+      _arena.Push(cache.free.data(), kBatchSize);
+      cache.free_num -= kBatchSize;
+      for (size_t i = 0; i < cache.free_num; ++i) {
+        cache.free[i] = cache.free[i + kBatchSize];
+      }
+    }
+    cache.free[cache.free_num++] = desc;
+  }
+
+  /**
+   * @brief Reuse a given descriptor after all the current epoch guards expire.
+   *
+   * @param desc A descriptor that may be referred by other threads.
+   */
+  static void
+  Retire(  //
+      Descriptor* const desc)
+  {
+    auto& cache = _cache;
+    if (cache.retired == nullptr) {
+      cache.retired = RetiredDescriptors::Create();
+    }
+    cache.retired->descs[cache.retired->num++] = desc;
+    if (cache.retired->num >= kBatchSize) {
+      _arena.gc->template AddGarbage<RetiredDescriptors>(cache.retired);
+      cache.retired = nullptr;
+    }
+  }
+
+ private:
+  /*##########################################################################*
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The number of descriptors moved at once between threads and the arena.
+  static constexpr size_t kBatchSize = Descriptor::kMaxReusableDescriptors;
+
+  /// @brief The maximum number of descriptors cached in each thread.
+  static constexpr size_t kCacheCapacity = 2 * kBatchSize;
+
+  /// @brief A flag for registering chunks with a descriptor table.
+  static constexpr bool kUseTable =
+      kUseDescriptorTable && std::is_constructible_v<Descriptor, uint64_t>;
+
+  static_assert(alignof(Descriptor) >= kCacheLineSize);
+  static_assert(kDescNumInChunk >= kBatchSize);
+
+  /*##########################################################################*
+   * Internal classes
+   *##########################################################################*/
+
+  /**
+   * @brief A class for retiring descriptors to the GC in a batch.
+   *
+   */
+  struct RetiredDescriptors {
+    /*########################################################################*
+     * GC settings
+     *########################################################################*/
+
+    /// @brief Call the destructor to return descriptors to the arena.
+    using T = RetiredDescriptors;
+
+    /// @brief Reuse allocated batches.
+    static constexpr bool kReusePages = true;
+
+    /*########################################################################*
+     * Public destructors
+     *########################################################################*/
+
+    /**
+     * @brief Return the retired descriptors to the arena.
+     *
+     */
+    ~RetiredDescriptors()
+    {
+      if constexpr (requires(Descriptor& desc) { desc.ReleaseGarbage(); }) {
+        for (size_t i = 0; i < num; ++i) {
+          descs[i]->ReleaseGarbage();  // e.g., pointers swapped by MwCAS
+        }
+      }
+      const std::lock_guard lock{_arena.mtx};
+      _arena.Push(descs.data(), num);
+    }
+
+    /*########################################################################*
+     * Public utilities
+     *########################################################################*/
+
+    /**
+     * @return An empty batch.
+     */
+    static auto
+    Create()  //
+        -> RetiredDescriptors*
+    {
+      auto* const gc = _arena.gc.get();
+      auto* const page = (gc) ? gc->template GetPageIfPossible<RetiredDescriptors>() : nullptr;
+      return (page == nullptr) ? new RetiredDescriptors{} : new (page) RetiredDescriptors{};
+    }
+
+    /*########################################################################*
+     * Public member variables
+     *########################################################################*/
+
+    /// @brief The number of retired descriptors.
+    size_t num{};
+
+    /// @brief Retired descriptors.
+    std::array<Descriptor*, kBatchSize> descs{};
+  };
+
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using EpochBasedGC = ::dbgroup::memory::EpochBasedGC<RetiredDescriptors>;
+
+  /**
+   * @brief A class for managing chunks of descriptors and their GC.
+   *
+   */
+  struct Arena {
+    /*########################################################################*
+     * Public destructors
+     *########################################################################*/
+
+    /**
+     * @brief Stop GC and release all the chunks.
+     *
+     */
+    ~Arena()
+    {
+      gc.reset();  // retired descriptors are returned to this arena
+      for (auto* chunk : chunks) {
+        if constexpr (!std::is_trivially_destructible_v<Descriptor>) {
+          auto* const head = static_cast<Descriptor*>(chunk);
+          for (size_t i = 0; i < kDescNumInChunk; ++i) {
+            head[i].~Descriptor();
+          }
+        }
+        ::operator delete(chunk, std::align_val_t{kDescChunkSize});
+      }
+    }
+
+    /*########################################################################*
+     * Public utilities
+     *########################################################################*/
+
+    /**
+     * @brief Allocate chunks until the arena can provide a given number of
+     * descriptors without allocation.
+     *
+     * @param desc_num The number of descriptors to be reserved.
+     */
+    void
+    Reserve(  //
+        const size_t desc_num)
+    {
+      while (free.size() < desc_num || free.size() < kBatchSize) {
+        const uint64_t chunk_id = chunks.size();
+        if constexpr (kUseTable) {
+          if (chunk_id >= kMaxChunkNum) throw std::bad_alloc{};
+        }
+
+        auto* const chunk = ::operator new(kDescChunkSize, std::align_val_t{kDescChunkSize});
+#if defined(MWCAS_USE_HUGE_PAGES) && defined(MADV_HUGEPAGE)
+        ::madvise(chunk, kDescChunkSize, MADV_HUGEPAGE);
+#endif
+        chunks.emplace_back(chunk);
+        free.reserve(chunks.size() * kDescNumInChunk);
+
+        // push descriptors in the reverse order to use them from the chunk head
+        auto* const head = static_cast<Descriptor*>(chunk);
+        for (size_t i = kDescNumInChunk; i > 0; --i) {
+          if constexpr (kUseTable) {
+            const auto index = (chunk_id << kSlotBitNum) | (i - 1);
+            free.emplace_back(new (head + (i - 1)) Descriptor{index});
+          } else {
+            free.emplace_back(new (head + (i - 1)) Descriptor{});
+          }
+        }
+        if constexpr (kUseTable) {
+          _table[chunk_id].store(head, std::memory_order_release);
+        }
+      }
+    }
+
+    /**
+     * @param[out] out A buffer to store free descriptors.
+     * @param num The number of descriptors to be popped.
+     * @return The number of popped descriptors.
+     */
+    auto
+    Pop(  //
+        Descriptor** const out,
+        const size_t num)  //
+        -> size_t
+    {
+      Reserve(num);
+      const auto begin = free.size() - num;
+      for (size_t i = 0; i < num; ++i) {
+        out[i] = free[begin + i];
+      }
+      free.resize(begin);
+      return num;
+    }
+
+    /**
+     * @param descs Descriptors to be returned.
+     * @param num The number of descriptors.
+     */
+    void
+    Push(  //
+        Descriptor* const* const descs,
+        const size_t num)
+    {
+      free.insert(free.end(), descs, descs + num);
+    }
+
+    /*########################################################################*
+     * Public member variables
+     *########################################################################*/
+
+    /// @brief A garbage collector for expired descriptors.
+    std::unique_ptr<EpochBasedGC> gc{};
+
+    /// @brief A mutex for protecting this arena.
+    std::mutex mtx{};
+
+    /// @brief Allocated chunks.
+    std::vector<void*> chunks{};
+
+    /// @brief Descriptors that can be reused immediately.
+    std::vector<Descriptor*> free{};
+  };
+
+  /**
+   * @brief A class for caching descriptors in each thread.
+   *
+   */
+  struct LocalCache {
+    /*########################################################################*
+     * Public destructors
+     *########################################################################*/
+
+    /**
+     * @brief Return cached descriptors to the arena.
+     *
+     */
+    ~LocalCache()
+    {
+      if (retired != nullptr) {
+        if (_arena.gc) {
+          _arena.gc->template AddGarbage<RetiredDescriptors>(retired);
+        } else {
+          // the GC has been stopped, so no threads refer to the descriptors
+          delete retired;
+        }
+      }
+      const std::lock_guard lock{_arena.mtx};
+      _arena.Push(free.data(), free_num);
+    }
+
+    /*########################################################################*
+     * Public member variables
+     *########################################################################*/
+
+    /// @brief The number of cached descriptors.
+    size_t free_num{};
+
+    /// @brief Descriptors that can be reused immediately.
+    std::array<Descriptor*, kCacheCapacity> free{};
+
+    /// @brief Descriptors waiting to be passed to the GC.
+    RetiredDescriptors* retired{};
+  };
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief An arena for all the descriptors.
+  static inline Arena _arena{};  // NOLINT
+
+  /// @brief A thread local cache of descriptors.
+  static inline thread_local LocalCache _cache{};  // NOLINT
+
+  /// @brief The head descriptors of chunks in the order of chunk IDs.
+  static inline std::array<std::atomic<Descriptor*>, (kUseTable) ? kMaxChunkNum : 0>
+      _table{};  // NOLINT
+};
+
+}  // namespace dbgroup::atomic::mwcas
+
+#endif  // DBGROUP_ATOMIC_MWCAS_DESCRIPTOR_POOL_HPP_
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_EXCLUSIVE_GUARD_HPP_
+#define DBGROUP_ATOMIC_MWCAS_EXCLUSIVE_GUARD_HPP_
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+
+// local sources
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas
+{
+/**
+ * @brief A guard class for performing MwCAS exclusively in the current thread.
+ *
+ * While an instance of this class is alive, the `MwCAS` functions of all the
+ * descriptors called by this thread compare and update target words by plain
+ * loads and stores without embedding descriptors. This is useful for bulk
+ * loading or recovery, where only one thread accesses target words.
+ *
+ * @note No other threads may read or modify target words in this scope, and
+ * MwCAS operations of other threads must have been completed before creating
+ * this guard (e.g., by joining them).
+ */
+class ExclusiveGuard
+{
+ public:
+  /*##########################################################################*
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Start the exclusive mode in this thread.
+   *
+   */
+  ExclusiveGuard()
+  {
+    std::atomic_thread_fence(kAcquire);
+    ++_depth;
+  }
+
+  ExclusiveGuard(const ExclusiveGuard&) = delete;
+  ExclusiveGuard(ExclusiveGuard&&) = delete;
+
+  auto operator=(const ExclusiveGuard& obj) -> ExclusiveGuard& = delete;
+  auto operator=(ExclusiveGuard&&) -> ExclusiveGuard& = delete;
+
+  /*##########################################################################*
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Return to the concurrent mode.
+   *
+   * All the stores in the exclusive mode are ordered before the later MwCAS
+   * operations of this thread and the threads synchronized with it.
+   */
+  ~ExclusiveGuard()
+  {
+    --_depth;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  /*##########################################################################*
+   * Public getters
+   *##########################################################################*/
+
+  /**
+   * @retval true if this thread is in the exclusive mode.
+   * @retval false otherwise.
+   */
+  [[nodiscard]]
+  static auto
+  IsActive()  //
+      -> bool
+  {
+    return _depth > 0;
+  }
+
+ private:
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The number of nested guards in this thread.
+  static inline thread_local size_t _depth{0};  // NOLINT
+};
+
+}  // namespace dbgroup::atomic::mwcas
+
+#endif  // DBGROUP_ATOMIC_MWCAS_EXCLUSIVE_GUARD_HPP_
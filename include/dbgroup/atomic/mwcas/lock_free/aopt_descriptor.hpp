@@ -27,11 +27,11 @@
 #include <utility>
 
 // external C++ libraries
-#include <dbgroup/memory/epoch_based_gc.hpp>
 #include <dbgroup/memory/utility.hpp>
 #include <dbgroup/thread/epoch_guard.hpp>
 
 // local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
 #include "dbgroup/atomic/mwcas/utility.hpp"
 
 namespace dbgroup::atomic::mwcas::lock_free
@@ -47,12 +47,6 @@ class alignas(kCacheLineSize) AOPTDescriptor
    * GC settings
    *##########################################################################*/
 
-  /// @brief Do not call destructors.
-  using T = void;
-
-  /// @brief Reuse allocated descriptors.
-  static constexpr bool kReusePages = true;
-
   /// @brief The number of retained descriptors in each thread.
   static constexpr size_t kMaxReusableDescriptors = 64;
 
@@ -108,11 +102,13 @@ class alignas(kCacheLineSize) AOPTDescriptor
    *
    * @param gc_interval Interval for GC in microseconds.
    * @param gc_thread_num The number of worker threads to release garbages.
+   * @param reserved_num The number of descriptors to be pre-allocated.
    * @note This function must be called before performing AOPT-based MwCAS.
    */
   static void StartGC(  //
       size_t gc_interval = ::dbgroup::memory::kDefaultGCTime,
-      size_t gc_thread_num = ::dbgroup::memory::kDefaultGCThreadNum);
+      size_t gc_thread_num = ::dbgroup::memory::kDefaultGCThreadNum,
+      size_t reserved_num = kDefaultReservedDescNum);
 
   /**
    * @brief Stop garbage collection for AOPT descriptors.
@@ -128,8 +124,8 @@ class alignas(kCacheLineSize) AOPTDescriptor
 
   /**
    * @return A new MwCAS descriptor for the AOPT algorithm.
-   * @note You must explicitly delete the given descriptor if you do not call
-   * the MwCAS function.
+   * @note The given descriptor is allocated from an internal arena, so you must
+   * not delete it. If you do not call the MwCAS function, it is not reused.
    */
   [[nodiscard]]
   static auto GetDescriptor()  //
@@ -162,6 +158,41 @@ class alignas(kCacheLineSize) AOPTDescriptor
         ReadInternal(static_cast<const std::atomic_uint64_t*>(addr), nullptr, fence).second);
   }
 
+  /**
+   * @brief Read values from given memory addresses at once.
+   *
+   * @tparam T An expected class of target fields.
+   * @param addrs Target memory addresses to read.
+   * @param[out] vals A buffer to store read values.
+   * @param num The number of target addresses.
+   * @param fence A flag for controling std::memory_order.
+   * @note This function prefetches all the addresses before reading them so
+   * that their cache misses overlap.
+   */
+  template <class T>
+  static void
+  ReadBatch(  //
+      const void* const* addrs,
+      T* vals,
+      const size_t num,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    BatchRead(addrs, vals, num, [fence](const void* addr) { return Read<T>(addr, fence); });
+  }
+
+  /**
+   * @brief Replace an AOPT descriptor embedded in a given word with its value.
+   *
+   * Completed descriptors remain in target words until their threads finalize
+   * them. This function removes such a descriptor so that other algorithms
+   * (e.g., deadlock-free MwCAS) can compare the word with a plain value.
+   *
+   * @param addr A target memory address.
+   * @note This function must be called in the scope of `CreateEpochGuard`.
+   */
+  static void Finalize(  //
+      void* addr);
+
   /**
    * @brief Add a new MwCAS target to this descriptor.
    *
@@ -180,6 +211,9 @@ class alignas(kCacheLineSize) AOPTDescriptor
       const std::memory_order fence = std::memory_order_seq_cst)
   {
     static_assert(CanMwCAS<T>());
+    if constexpr (kPrefetchTargets) {
+      PrefetchForWrite(addr);
+    }
 
     targets_.at(target_cnt_++) =
         MwCASTarget{static_cast<std::atomic_uint64_t*>(addr), old_val, new_val, fence};
@@ -199,7 +233,7 @@ class alignas(kCacheLineSize) AOPTDescriptor
    * Type aliases
    *##########################################################################*/
 
-  using EpochBasedGC = ::dbgroup::memory::EpochBasedGC<AOPTDescriptor>;
+  using Pool = DescriptorPool<AOPTDescriptor>;
 
   /*##########################################################################*
    * Internal types
@@ -322,6 +356,15 @@ class alignas(kCacheLineSize) AOPTDescriptor
       std::memory_order fence)  //
       -> std::pair<uint64_t, uint64_t>;
 
+  /**
+   * @brief Perform MwCAS by plain loads and stores in the exclusive mode.
+   *
+   * @retval true if all the target words have their expected values.
+   * @retval false otherwise.
+   */
+  auto MwCASExclusively()  //
+      -> bool;
+
   /**
    * @brief An actual MwCAS procedure.
    *
@@ -345,9 +388,6 @@ class alignas(kCacheLineSize) AOPTDescriptor
 
   /// @brief The number of registered MwCAS targets.
   size_t target_cnt_{};
-
-  /// @brief A garbage collector for expired descriptors.
-  static inline std::unique_ptr<EpochBasedGC> _gc{};  // NOLINT
 };
 
 }  // namespace dbgroup::atomic::mwcas::lock_free
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_LOCK_FREE_AWAITABLE_HPP_
+#define DBGROUP_ATOMIC_MWCAS_LOCK_FREE_AWAITABLE_HPP_
+
+// C++ standard libraries
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// local sources
+#include "dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas::lock_free
+{
+/*############################################################################*
+ * Concepts
+ *############################################################################*/
+
+/**
+ * @brief A concept for functions for preparing MwCAS targets.
+ *
+ * A function receives a descriptor given by `GetDescriptor` and registers MwCAS
+ * targets with it. It returns `Preparation::kRetry` if it cannot register
+ * targets now (e.g., `TryRead` has failed), and then it is called again after
+ * back-off. It returns `Preparation::kAbort` to give up the operation.
+ */
+template <class F>
+concept MwCASPreparer =
+    std::invocable<F&, MwCASDescriptor*>
+    && std::same_as<std::invoke_result_t<F&, MwCASDescriptor*>, Preparation>;
+
+/*############################################################################*
+ * Coroutines
+ *############################################################################*/
+
+/**
+ * @brief Read a value from a given memory address without blocking threads.
+ *
+ * Instead of sleeping, this coroutine awaits `back_off()` while a descriptor is
+ * embedded. If the descriptor is still embedded after the back-off, it helps the
+ * descriptor as `MwCASDescriptor::Read` does.
+ *
+ * @tparam Task A coroutine type of an executor, whose promise accepts
+ * `co_return` of `std::pair<T, T>` and `co_await` of back-off.
+ * @tparam T An expected class of a target field.
+ * @tparam BackOff A function returning an awaitable for back-off.
+ * @param addr A target memory address to read.
+ * @param back_off A function for creating a scheduler-provided back-off.
+ * @param fence A flag for controling std::memory_order.
+ * @return A task returning the pair of a read value and its word.
+ * @note An epoch guard is created for each trial because the coroutine may be
+ * resumed by another thread.
+ */
+template <template <class> class Task, class T, class BackOff>
+auto
+ReadAsync(  //
+    void* const addr,
+    BackOff back_off,
+    const std::memory_order fence = std::memory_order_seq_cst)  //
+    -> Task<std::pair<T, T>>
+{
+  uint64_t stalled = 0;
+  while (true) {
+    {
+      [[maybe_unused]] const auto& guard = MwCASDescriptor::CreateEpochGuard();
+      if (const auto val = MwCASDescriptor::TryRead<T>(addr, stalled, fence); val) co_return *val;
+    }
+    co_await back_off();
+  }
+}
+
+/**
+ * @brief Perform MwCAS until it succeeds or is aborted without blocking threads.
+ *
+ * This function gets a descriptor, calls `prepare` for registering targets, and
+ * performs MwCAS. If `prepare` returns `Preparation::kRetry` or MwCAS fails, it
+ * backs off and starts over with a new descriptor.
+ *
+ * @tparam Task A coroutine type of an executor, whose promise accepts
+ * `co_return` of `bool` and `co_await` of back-off.
+ * @tparam Prepare A function for registering MwCAS targets.
+ * @tparam BackOff A function returning an awaitable for back-off.
+ * @param prepare A function for registering MwCAS targets.
+ * @param back_off A function for creating a scheduler-provided back-off.
+ * @return A task returning true if MwCAS succeeds or false if `prepare` has
+ * aborted the operation.
+ * @note `prepare` is called in the scope of an epoch guard.
+ */
+template <template <class> class Task, MwCASPreparer Prepare, class BackOff>
+auto
+MwCASAsync(  //
+    Prepare prepare,
+    BackOff back_off)  //
+    -> Task<bool>
+{
+  while (true) {
+    {
+      // do not hold the epoch guard across suspension
+      [[maybe_unused]] const auto& guard = MwCASDescriptor::CreateEpochGuard();
+      auto* const desc = MwCASDescriptor::GetDescriptor();
+      const auto prepared = prepare(desc);
+      if (prepared == Preparation::kReady) {
+        if (desc->MwCAS()) co_return true;
+      } else {
+        MwCASDescriptor::ReleaseDescriptor(desc);
+        if (prepared == Preparation::kAbort) co_return false;
+      }
+    }
+    co_await back_off();
+  }
+}
+
+}  // namespace dbgroup::atomic::mwcas::lock_free
+
+#endif  // DBGROUP_ATOMIC_MWCAS_LOCK_FREE_AWAITABLE_HPP_
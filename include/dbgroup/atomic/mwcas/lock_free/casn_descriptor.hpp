@@ -27,11 +27,11 @@
 
 // external C++ libraries
 #include <dbgroup/lock/utility.hpp>
-#include <dbgroup/memory/epoch_based_gc.hpp>
 #include <dbgroup/memory/utility.hpp>
 #include <dbgroup/thread/epoch_guard.hpp>
 
 // local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
 #include "dbgroup/atomic/mwcas/utility.hpp"
 
 namespace dbgroup::atomic::mwcas::lock_free
@@ -47,12 +47,6 @@ class alignas(kCacheLineSize) CASNDescriptor
    * GC settings
    *##########################################################################*/
 
-  /// @brief Do not call destructors.
-  using T = void;
-
-  /// @brief Reuse allocated descriptors.
-  static constexpr bool kReusePages = true;
-
   /// @brief The number of retained descriptors in each thread.
   static constexpr size_t kMaxReusableDescriptors = 64;
 
@@ -106,11 +100,13 @@ class alignas(kCacheLineSize) CASNDescriptor
    *
    * @param gc_interval Interval for GC in microseconds.
    * @param gc_thread_num The number of worker threads to release garbages.
+   * @param reserved_num The number of descriptors to be pre-allocated.
    * @note This function must be called before performing CASN-based MwCAS.
    */
   static void StartGC(  //
       size_t gc_interval = ::dbgroup::memory::kDefaultGCTime,
-      size_t gc_thread_num = ::dbgroup::memory::kDefaultGCThreadNum);
+      size_t gc_thread_num = ::dbgroup::memory::kDefaultGCThreadNum,
+      size_t reserved_num = kDefaultReservedDescNum);
 
   /**
    * @brief Stop garbage collection for CASN descriptors.
@@ -126,8 +122,8 @@ class alignas(kCacheLineSize) CASNDescriptor
 
   /**
    * @return A new MwCAS descriptor for the CASN algorithm.
-   * @note You must explicitly delete the given descriptor if you do not call
-   * the MwCAS function.
+   * @note The given descriptor is allocated from an internal arena, so you must
+   * not delete it. If you do not call the MwCAS function, it is not reused.
    */
   [[nodiscard]]
   static auto GetDescriptor()  //
@@ -159,7 +155,7 @@ class alignas(kCacheLineSize) CASNDescriptor
     const auto* const target_addr = static_cast<const std::atomic_uint64_t*>(addr);
     auto cur = target_addr->load(fence);
     while (true) {
-      while (cur & kRDCSSFlag) {
+      while (cur & kRDCSSPhaseFlag) {
         CompleteRDCSS(cur);
       }
       if ((cur & kMwCASFlag) == 0) break;
@@ -173,6 +169,28 @@ class alignas(kCacheLineSize) CASNDescriptor
     return std::bit_cast<T>(cur);
   }
 
+  /**
+   * @brief Read values from given memory addresses at once.
+   *
+   * @tparam T An expected class of target fields.
+   * @param addrs Target memory addresses to read.
+   * @param[out] vals A buffer to store read values.
+   * @param num The number of target addresses.
+   * @param fence A flag for controling std::memory_order.
+   * @note This function prefetches all the addresses before reading them so
+   * that their cache misses overlap.
+   */
+  template <class T>
+  static void
+  ReadBatch(  //
+      const void* const* addrs,
+      T* vals,
+      const size_t num,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    BatchRead(addrs, vals, num, [fence](const void* addr) { return Read<T>(addr, fence); });
+  }
+
   /**
    * @brief Add a new MwCAS target to this descriptor.
    *
@@ -191,6 +209,9 @@ class alignas(kCacheLineSize) CASNDescriptor
       const std::memory_order fence = std::memory_order_seq_cst)
   {
     static_assert(CanMwCAS<T>());
+    if constexpr (kPrefetchTargets) {
+      PrefetchForWrite(addr);
+    }
 
     targets_.at(target_cnt_++) =
         MwCASTarget{static_cast<std::atomic_uint64_t*>(addr), old_val, new_val, fence};
@@ -210,7 +231,7 @@ class alignas(kCacheLineSize) CASNDescriptor
    * Type aliases
    *##########################################################################*/
 
-  using EpochBasedGC = ::dbgroup::memory::EpochBasedGC<CASNDescriptor>;
+  using Pool = DescriptorPool<CASNDescriptor>;
 
   /*##########################################################################*
    * Internal types
@@ -248,11 +269,12 @@ class alignas(kCacheLineSize) CASNDescriptor
    * Internal constants
    *##########################################################################*/
 
-  /// @brief The second bit from the last indicates RDCSS descriptors.
-  static constexpr uint64_t kRDCSSFlag = 1UL << 62UL;
+  /// @brief The second bit from the last indicates descriptors in the RDCSS phase.
+  /// @note This differs from the global `kRDCSSFlag` of `RDCSSDescriptor`.
+  static constexpr uint64_t kRDCSSPhaseFlag = 1UL << 62UL;
 
   /// @brief A bit mask for swapping flags with XOR.
-  static constexpr uint64_t kFlagSwap = kMwCASFlag | kRDCSSFlag;
+  static constexpr uint64_t kFlagSwap = kMwCASFlag | kRDCSSPhaseFlag;
 
   /// @brief The bit position for indicating the original number of a target.
   static constexpr uint64_t kCntPos = 47;
@@ -261,7 +283,7 @@ class alignas(kCacheLineSize) CASNDescriptor
   static constexpr uint64_t kPtrMask = (1UL << kCntPos) - 1UL;
 
   /// @brief A bit mask for extracting the original number of a target.
-  static constexpr uint64_t kCntMask = ~kPtrMask ^ (kMwCASFlag | kRDCSSFlag);
+  static constexpr uint64_t kCntMask = ~kPtrMask ^ (kMwCASFlag | kRDCSSPhaseFlag);
 
   /*##########################################################################*
    * Internal utility functions
@@ -275,6 +297,15 @@ class alignas(kCacheLineSize) CASNDescriptor
   static void CompleteRDCSS(  //
       uint64_t& rdcss_addr);
 
+  /**
+   * @brief Perform MwCAS by plain loads and stores in the exclusive mode.
+   *
+   * @retval true if all the target words have their expected values.
+   * @retval false otherwise.
+   */
+  auto MwCASExclusively()  //
+      -> bool;
+
   /**
    * @brief An actual MwCAS procedure.
    *
@@ -310,9 +341,6 @@ class alignas(kCacheLineSize) CASNDescriptor
 
   /// @brief The number of registered MwCAS targets.
   size_t target_cnt_{};
-
-  /// @brief A garbage collector for expired descriptors.
-  static inline std::unique_ptr<EpochBasedGC> _gc{};  // NOLINT
 };
 
 }  // namespace dbgroup::atomic::mwcas::lock_free
@@ -0,0 +1,259 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_LOCK_FREE_COMBINING_MWCAS_HPP_
+#define DBGROUP_ATOMIC_MWCAS_LOCK_FREE_COMBINING_MWCAS_HPP_
+
+// C++ standard libraries
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// external C++ libraries
+#include <dbgroup/lock/utility.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+// a fixture for accessing shards in unit tests
+class CombiningMwCASFixture;
+}  // namespace dbgroup::atomic::mwcas::test
+
+namespace dbgroup::atomic::mwcas::lock_free
+{
+/**
+ * @brief A class for performing MwCAS operations with flat combining on hot spots.
+ *
+ * Operations are grouped into shards by given keys (e.g., the address of a hot
+ * target word). While a shard is cool, each operation is performed as a usual
+ * lock-free MwCAS. If MwCAS operations in a shard often fail, the shard becomes
+ * hot, and operations are published to its publication list. Then, one of the
+ * publishing threads becomes a combiner and performs the published operations
+ * one by one, so the other threads do not touch the hot target words.
+ *
+ * @note This class uses descriptors of `MwCASDescriptor`, so its GC must be
+ * started in advance.
+ */
+class CombiningMwCAS
+{
+ public:
+  /*##########################################################################*
+   * Public APIs
+   *##########################################################################*/
+
+  /**
+   * @brief Perform a MwCAS operation by combining it with others if needed.
+   *
+   * A given function reads target words via `MwCASDescriptor::Read` and
+   * registers MwCAS targets to a given descriptor. It may be called by another
+   * thread (i.e., a combiner) and retried until MwCAS succeeds, so it must not
+   * have any other side effects.
+   *
+   * @tparam Func A class of functions with `bool(MwCASDescriptor*)`.
+   * @param key A key for selecting a shard (e.g., the address of a hot word).
+   * @param func A function for preparing a MwCAS operation. It returns false
+   * if the operation should be aborted.
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false if the operation has been aborted.
+   */
+  template <class Func>
+  static auto
+  Execute(  //
+      const void* const key,
+      const Func& func)  //
+      -> bool
+  {
+    auto& shard = GetShard(key);
+    while (true) {
+      while (shard.contention.load(kRelaxed) < kHotThreshold) {
+        [[maybe_unused]] const auto& guard = MwCASDescriptor::CreateEpochGuard();
+        auto* const desc = MwCASDescriptor::GetDescriptor();
+        if (!func(desc)) {
+          MwCASDescriptor::Pool::Recycle(desc);
+          return false;
+        }
+        if (desc->MwCAS()) {
+          // decrement the counter without wrapping around below zero
+          auto cnt = shard.contention.load(kRelaxed);
+          while (cnt > 0
+                 && !shard.contention.compare_exchange_weak(cnt, cnt - 1, kRelaxed, kRelaxed)) {
+            CPP_UTILITY_SPINLOCK_HINT
+          }
+          return true;
+        }
+        shard.contention.fetch_add(1, kRelaxed);
+      }
+
+      // a combiner may give up the request, so retry it in that case
+      Request req{Operation{&Invoke<Func>, &func}};
+      const auto status = Combine(shard, req);
+      if (status != kRetry) return status == kSucceeded;
+    }
+  }
+
+ private:
+  /*##########################################################################*
+   * Friend classes
+   *##########################################################################*/
+
+  friend class ::dbgroup::atomic::mwcas::test::CombiningMwCASFixture;
+
+  /*##########################################################################*
+   * Internal types
+   *##########################################################################*/
+
+  /**
+   * @brief An enumeration for representing the results of published operations.
+   *
+   */
+  enum Status : uint64_t {
+    kSucceeded = 0,
+    kAborted,
+    kRetry,
+  };
+
+  /**
+   * @brief A class for representing type-erased operations.
+   *
+   */
+  struct Operation {
+    /// @brief A function for invoking a given operation.
+    bool (*invoke)(const void*, MwCASDescriptor*);
+
+    /// @brief A given operation.
+    const void* func;
+  };
+
+  /**
+   * @brief A class for representing published operations.
+   *
+   */
+  struct Request {
+    /// @brief A published operation.
+    Operation op;
+
+    /// @brief The next request in a publication list.
+    Request* next{nullptr};
+
+    /// @brief The result of the operation.
+    Status status{kRetry};
+
+    /// @brief A flag for indicating the operation has been completed.
+    std::atomic_bool done{false};
+  };
+
+  /**
+   * @brief A class for representing a group of hot target words.
+   *
+   */
+  struct alignas(kCacheLineSize) Shard {
+    /// @brief The head of a publication list.
+    std::atomic<Request*> head{nullptr};
+
+    /// @brief A flag for indicating a combiner is running.
+    std::atomic_bool combining{false};
+
+    /// @brief A counter for detecting frequent MwCAS failures.
+    std::atomic_size_t contention{0};
+  };
+
+  /*##########################################################################*
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The number of shards.
+  static constexpr size_t kShardNum = 64;
+
+  /// @brief A shard becomes hot if its contention counter reaches this value.
+  static constexpr size_t kHotThreshold = 64;
+
+  /*##########################################################################*
+   * Internal utility functions
+   *##########################################################################*/
+
+  /**
+   * @tparam Func A class of functions with `bool(MwCASDescriptor*)`.
+   * @param func A type-erased function.
+   * @param desc A descriptor for preparing a MwCAS operation.
+   * @return The result of the given function.
+   */
+  template <class Func>
+  static auto
+  Invoke(  //
+      const void* func,
+      MwCASDescriptor* desc)  //
+      -> bool
+  {
+    return (*static_cast<const Func*>(func))(desc);
+  }
+
+  /**
+   * @param key A key for selecting a shard.
+   * @return The shard corresponding to the key.
+   */
+  static auto
+  GetShard(  //
+      const void* const key)  //
+      -> Shard&
+  {
+    // use Fibonacci hashing for spreading neighboring cache lines
+    constexpr uint64_t kMul = 0x9E3779B97F4A7C15UL;
+    constexpr uint64_t kShift = 64 - std::bit_width(kShardNum - 1);
+    return _shards[((std::bit_cast<uint64_t>(key) >> 6UL) * kMul) >> kShift];
+  }
+
+  /**
+   * @brief Publish a request and wait for its completion by combiners.
+   *
+   * @param shard A target shard.
+   * @param req A request to be published.
+   * @retval kSucceeded if the operation succeeds.
+   * @retval kAborted if the operation has been aborted.
+   * @retval kRetry if a combiner gave up the operation.
+   */
+  static auto Combine(  //
+      Shard& shard,
+      Request& req)  //
+      -> Status;
+
+  /**
+   * @brief Perform a published operation with a bounded number of retries.
+   *
+   * @param op A target operation.
+   * @retval kSucceeded if the operation succeeds.
+   * @retval kAborted if the operation has been aborted.
+   * @retval kRetry if MwCAS keeps failing, so the requester should retry it.
+   */
+  static auto Apply(  //
+      const Operation& op)  //
+      -> Status;
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief Shards of hot target words.
+  static std::array<Shard, kShardNum> _shards;  // NOLINT
+};
+
+}  // namespace dbgroup::atomic::mwcas::lock_free
+
+#endif  // DBGROUP_ATOMIC_MWCAS_LOCK_FREE_COMBINING_MWCAS_HPP_
@@ -0,0 +1,386 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_LOCK_FREE_MWCAS128_DESCRIPTOR_HPP_
+#define DBGROUP_ATOMIC_MWCAS_LOCK_FREE_MWCAS128_DESCRIPTOR_HPP_
+
+// C++ standard libraries
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// external C++ libraries
+#include <dbgroup/memory/utility.hpp>
+#include <dbgroup/thread/epoch_guard.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas::lock_free
+{
+/**
+ * @brief A class to manage a MwCAS operation over 16-byte target words.
+ *
+ * Each target word consists of a 64-bit payload and 64-bit metadata managed by
+ * this class (i.e., a MwCAS flag and a 63-bit version). Since the payload has no
+ * reserved bits, any 8-byte class (e.g., tagged pointers) can be swapped, and
+ * the version prevents ABA problems. Target words are updated by 16-byte CAS
+ * instructions (e.g., `cmpxchg16b` on x86-64).
+ *
+ * @note Without 16-byte CAS instructions (i.e., `__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16`
+ * is not defined), target words are accessed via `std::atomic_ref`, which may
+ * fall back to the locks of libatomic. MwCAS is still correct, but it is no
+ * longer lock-free.
+ */
+class alignas(kCacheLineSize) MwCAS128Descriptor
+{
+ public:
+  /*##########################################################################*
+   * GC settings
+   *##########################################################################*/
+
+  /// @brief The number of retained descriptors in each thread.
+  static constexpr size_t kMaxReusableDescriptors = 64;
+
+  /*##########################################################################*
+   * Public types
+   *##########################################################################*/
+
+  /**
+   * @brief A class for representing 16-byte target words.
+   *
+   */
+  struct alignas(2 * sizeof(uint64_t)) Word {
+    /// @brief A payload or the address of an embedded descriptor.
+    uint64_t val{};
+
+    /// @brief A version or the information of an embedded descriptor.
+    uint64_t meta{};
+
+    constexpr auto operator==(const Word&) const -> bool = default;
+  };
+
+  /*##########################################################################*
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct an empty descriptor for MwCAS operations.
+   *
+   */
+  constexpr MwCAS128Descriptor() = default;
+
+  MwCAS128Descriptor(const MwCAS128Descriptor&) = delete;
+  MwCAS128Descriptor(MwCAS128Descriptor&&) = delete;
+
+  auto operator=(const MwCAS128Descriptor& obj) -> MwCAS128Descriptor& = delete;
+  auto operator=(MwCAS128Descriptor&&) -> MwCAS128Descriptor& = delete;
+
+  /*##########################################################################*
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the MwCAS128Descriptor object.
+   *
+   */
+  ~MwCAS128Descriptor() = default;
+
+  /*##########################################################################*
+   * Public getters/setters
+   *##########################################################################*/
+
+  /**
+   * @return The number of registered MwCAS targets.
+   */
+  [[nodiscard]]
+  constexpr auto
+  Size() const  //
+      -> size_t
+  {
+    return target_cnt_;
+  }
+
+  /*##########################################################################*
+   * Public APIs for managing memory
+   *##########################################################################*/
+
+  /**
+   * @brief Start garbage collection for this descriptors.
+   *
+   * @param gc_interval Interval for GC in microseconds.
+   * @param gc_thread_num The number of worker threads to release garbages.
+   * @param reserved_num The number of descriptors to be pre-allocated.
+   * @note This function must be called before performing MwCAS.
+   */
+  static void StartGC(  //
+      size_t gc_interval = ::dbgroup::memory::kDefaultGCTime,
+      size_t gc_thread_num = ::dbgroup::memory::kDefaultGCThreadNum,
+      size_t reserved_num = kDefaultReservedDescNum);
+
+  /**
+   * @brief Stop garbage collection for this descriptors.
+   *
+   */
+  static void StopGC();
+
+  /**
+   * @return A guard instance for preventing GC.
+   */
+  static auto CreateEpochGuard()  //
+      -> ::dbgroup::thread::EpochGuard;
+
+  /**
+   * @return A new descriptor for the MwCAS algorithm.
+   * @note The given descriptor is allocated from an internal arena, so you must
+   * not delete it. If you do not call the MwCAS function, it is not reused.
+   */
+  [[nodiscard]]
+  static auto GetDescriptor()  //
+      -> MwCAS128Descriptor*;
+
+  /*##########################################################################*
+   * Public utility functions
+   *##########################################################################*/
+
+  /**
+   * @brief Read a value from a given memory address.
+   *
+   * @tparam T An expected class of a target payload.
+   * @param addr A target memory address to read.
+   * @param fence A flag for controling std::memory_order.
+   * @retval 1st: A read payload.
+   * @retval 2nd: A read word to be used as an expected one of MwCAS.
+   * @note If a memory address is included in MwCAS target fields, it must be
+   * read via this function.
+   */
+  template <class T>
+  static auto
+  Read(  //
+      Word* const addr,
+      const std::memory_order fence = std::memory_order_seq_cst)  //
+      -> std::pair<T, Word>
+  {
+    static_assert(sizeof(T) == sizeof(uint64_t) && std::is_trivially_copyable_v<T>);
+
+    auto word = Load(addr, fence);
+    while (word.meta & kMwCASFlag) {
+      FollowIfNeeded(addr, word, fence);
+    }
+    return std::pair{std::bit_cast<T>(word.val), word};
+  }
+
+  /**
+   * @brief Add a new MwCAS target to this descriptor.
+   *
+   * @tparam T The class of a target payload.
+   * @param addr A target memory address.
+   * @param old_word The expected word given by `Read`.
+   * @param new_val An inserting payload into a target field.
+   * @param fence A flag for controling std::memory_order.
+   */
+  template <class T>
+  void
+  AddMwCASTarget(  //
+      Word* const addr,
+      const Word old_word,
+      const T new_val,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    static_assert(sizeof(T) == sizeof(uint64_t) && std::is_trivially_copyable_v<T>);
+    if constexpr (kPrefetchTargets) {
+      PrefetchForWrite(addr);
+    }
+
+    auto& target = targets_.at(target_cnt_++);
+    target.addr = addr;
+    target.fence = fence;
+    target.old_word = old_word;
+    target.new_val = std::bit_cast<uint64_t>(new_val);
+  }
+
+  /**
+   * @brief Perform a MwCAS operation by using registered targets.
+   *
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto MwCAS()  //
+      -> bool;
+
+ private:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using Pool = DescriptorPool<MwCAS128Descriptor>;
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+  using Word128 = unsigned __int128;
+#endif
+
+  /*##########################################################################*
+   * Internal types
+   *##########################################################################*/
+
+  /**
+   * @brief An enumeration for representing MwCAS status.
+   *
+   */
+  enum Status : uint64_t {
+    kUndecided = 0,
+    kSucceeded,
+    kFailed,
+  };
+
+  /**
+   * @brief A class for representing MwCAS targets.
+   *
+   */
+  struct MwCASTarget {
+    /// @brief An expected word of a target field.
+    Word old_word;
+
+    /// @brief A target memory address.
+    Word* addr;
+
+    /// @brief An inserting payload into a target field.
+    uint64_t new_val;
+
+    /// @brief A fence to be inserted when embedding a new value.
+    std::memory_order fence;
+  };
+
+  /*##########################################################################*
+   * Internal utility functions
+   *##########################################################################*/
+
+  /**
+   * @param addr A target address.
+   * @param fence A memory fence.
+   * @return The current word of a target address.
+   */
+  static auto
+  Load(  //
+      Word* const addr,
+      [[maybe_unused]] const std::memory_order fence)  //
+      -> Word
+  {
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    // a 16-byte CAS that never changes a word reads it atomically
+    auto* const word = std::bit_cast<Word128*>(addr);
+    return std::bit_cast<Word>(__sync_val_compare_and_swap(word, Word128{0}, Word128{0}));
+#else
+    return std::atomic_ref<Word>{*addr}.load(fence);
+#endif
+  }
+
+  /**
+   * @param addr A target address.
+   * @param[in,out] expected An expected word.
+   * @param desired A desired word.
+   * @param fence A memory fence for success.
+   * @retval true if the target word is swapped.
+   * @retval false otherwise.
+   */
+  static auto
+  CAS(  //
+      Word* const addr,
+      Word& expected,
+      const Word desired,
+      [[maybe_unused]] const std::memory_order fence)  //
+      -> bool
+  {
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    // use the same primitive as the coalesced targets of `MwCASDescriptor`
+    const auto old_word = std::bit_cast<Word128>(expected);
+    const auto cur_word = __sync_val_compare_and_swap(std::bit_cast<Word128*>(addr), old_word,
+                                                      std::bit_cast<Word128>(desired));
+    expected = std::bit_cast<Word>(cur_word);
+    return cur_word == old_word;
+#else
+    return std::atomic_ref<Word>{*addr}.compare_exchange_strong(expected, desired, fence,
+                                                                std::memory_order_relaxed);
+#endif
+  }
+
+  /**
+   * @brief Insert back-off and follow the existing MwCAS if needed.
+   *
+   * @param[in] addr A target address.
+   * @param[in,out] word The current value of a target address.
+   * @param[in] fence A memory fence.
+   */
+  static void FollowIfNeeded(  //
+      Word* addr,
+      Word& word,
+      std::memory_order fence);
+
+  /**
+   * @brief Swap an embedded descriptor into a desired value.
+   *
+   * @param target A target MwCAS information.
+   * @param desired A desired value to be embedded.
+   * @retval true if this descriptor may be referred by other threads.
+   * @retval false otherwise.
+   */
+  auto Finalize(            //
+      MwCASTarget& target,  //
+      Word desired)         //
+      -> bool;
+
+  /**
+   * @brief Perform MwCAS by plain loads and stores in the exclusive mode.
+   *
+   * @retval true if all the target words have their expected values.
+   * @retval false otherwise.
+   */
+  auto MwCASExclusively()  //
+      -> bool;
+
+  /**
+   * @brief An actual MwCAS procedure.
+   *
+   * @param begin_pos The begin position of target words.
+   * @retval 1st: true if a MwCAS operation succeeds.
+   * @retval 2nd: true if this descriptor may be referred by other threads.
+   */
+  auto MwCASInternal(        //
+      size_t begin_pos = 0)  //
+      -> std::pair<bool, bool>;
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The status of this descriptor.
+  std::atomic<Status> stat_{kUndecided};
+
+  /// @brief The number of registered MwCAS targets.
+  size_t target_cnt_{};
+
+  /// @brief Target entries of MwCAS.
+  std::array<MwCASTarget, kMwCASCapacity> targets_ = {};
+};
+
+}  // namespace dbgroup::atomic::mwcas::lock_free
+
+#endif  // DBGROUP_ATOMIC_MWCAS_LOCK_FREE_MWCAS128_DESCRIPTOR_HPP_
@@ -23,14 +23,17 @@
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
 #include <utility>
 
 // external C++ libraries
-#include <dbgroup/memory/epoch_based_gc.hpp>
 #include <dbgroup/memory/utility.hpp>
 #include <dbgroup/thread/epoch_guard.hpp>
 
 // local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
 #include "dbgroup/atomic/mwcas/utility.hpp"
 
 namespace dbgroup::atomic::mwcas::lock_free
@@ -38,6 +41,12 @@ namespace dbgroup::atomic::mwcas::lock_free
 /**
  * @brief A class to manage a MwCAS (multi-words compare-and-swap) operation.
  *
+ * Each target word has a version above `kValueBitNum` bits, which prevents a
+ * delayed helper from embedding a completed descriptor again. If
+ * `MWCAS_UNVERSIONED_VALUES` is defined, values can use 63 bits instead, and
+ * helpers abort stalled MwCAS operations rather than completing them. Since an
+ * aborted MwCAS only restores the values replaced by its descriptor, delayed
+ * embedding cannot cause ABA problems in this mode.
  */
 class alignas(kCacheLineSize) MwCASDescriptor
 {
@@ -46,15 +55,33 @@ class alignas(kCacheLineSize) MwCASDescriptor
    * GC settings
    *##########################################################################*/
 
-  /// @brief Do not call destructors.
-  using T = void;
-
-  /// @brief Reuse allocated descriptors.
-  static constexpr bool kReusePages = true;
-
   /// @brief The number of retained descriptors in each thread.
   static constexpr size_t kMaxReusableDescriptors = 64;
 
+  /*##########################################################################*
+   * Public constants
+   *##########################################################################*/
+
+  /// @brief The maximum number of target words including overflowed ones.
+  static constexpr size_t kMaxTargetNum = 32;
+
+  static_assert(kMwCASCapacity <= kMaxTargetNum);
+
+  /*##########################################################################*
+   * Public types
+   *##########################################################################*/
+
+  /**
+   * @brief An enumeration for selecting pointers to be reclaimed after MwCAS.
+   *
+   */
+  enum RecyclePolicy : uint64_t {
+    kRecycleNever = 0,
+    kRecycleOldOnSuccess = 1,
+    kRecycleNewOnFailure = 2,
+    kRecycleAlways = kRecycleOldOnSuccess | kRecycleNewOnFailure,
+  };
+
   /*##########################################################################*
    * Public constructors and assignment operators
    *##########################################################################*/
@@ -65,6 +92,17 @@ class alignas(kCacheLineSize) MwCASDescriptor
    */
   constexpr MwCASDescriptor() = default;
 
+  /**
+   * @brief Construct an empty descriptor registered with a descriptor table.
+   *
+   * @param index The index of this descriptor in the descriptor table.
+   */
+  explicit constexpr MwCASDescriptor(  //
+      const uint64_t index)
+      : index_{index}
+  {
+  }
+
   MwCASDescriptor(const MwCASDescriptor&) = delete;
   MwCASDescriptor(MwCASDescriptor&&) = delete;
 
@@ -96,6 +134,17 @@ class alignas(kCacheLineSize) MwCASDescriptor
     return target_cnt_;
   }
 
+  /**
+   * @return The number of pointers to be reclaimed with this descriptor.
+   */
+  [[nodiscard]]
+  constexpr auto
+  RecycleSize() const  //
+      -> size_t
+  {
+    return recycle_cnt_;
+  }
+
   /*##########################################################################*
    * Public APIs for managing memory
    *##########################################################################*/
@@ -105,11 +154,13 @@ class alignas(kCacheLineSize) MwCASDescriptor
    *
    * @param gc_interval Interval for GC in microseconds.
    * @param gc_thread_num The number of worker threads to release garbages.
+   * @param reserved_num The number of descriptors to be pre-allocated.
    * @note This function must be called before performing MwCAS.
    */
   static void StartGC(  //
       size_t gc_interval = ::dbgroup::memory::kDefaultGCTime,
-      size_t gc_thread_num = ::dbgroup::memory::kDefaultGCThreadNum);
+      size_t gc_thread_num = ::dbgroup::memory::kDefaultGCThreadNum,
+      size_t reserved_num = kDefaultReservedDescNum);
 
   /**
    * @brief Stop garbage collection for this descriptors.
@@ -125,13 +176,26 @@ class alignas(kCacheLineSize) MwCASDescriptor
 
   /**
    * @return A new descriptor for the MwCAS algorithm.
-   * @note You must explicitly delete the given descriptor if you do not call
-   * the MwCAS function.
+   * @note The given descriptor is allocated from an internal arena, so you must
+   * not delete it. If you do not call the MwCAS function, return it via
+   * `ReleaseDescriptor` for reusing it.
    */
   [[nodiscard]]
   static auto GetDescriptor()  //
       -> MwCASDescriptor*;
 
+  /**
+   * @brief Return a descriptor without performing MwCAS.
+   *
+   * @param desc A descriptor given by `GetDescriptor`.
+   */
+  static void
+  ReleaseDescriptor(  //
+      MwCASDescriptor* const desc)
+  {
+    Pool::Recycle(desc);
+  }
+
   /*##########################################################################*
    * Public utility functions
    *##########################################################################*/
@@ -163,9 +227,77 @@ class alignas(kCacheLineSize) MwCASDescriptor
     return std::pair{std::bit_cast<T>(word & kValueMask), std::bit_cast<T>(word)};
   }
 
+  /**
+   * @brief Read a value from a given memory address without sleeping.
+   *
+   * If a descriptor remains embedded after spinning, this function reports the
+   * blocking word via `stalled` instead of sleeping. Callers should back off
+   * (e.g., yield to other tasks) and retry with the same `stalled`. Then, if the
+   * descriptor has not made progress during the back-off, this function helps
+   * it as `Read` does after sleeping.
+   *
+   * @tparam T An expected class of a target field.
+   * @param addr A target memory address to read.
+   * @param[in,out] stalled A word blocked at the last call (initially zero).
+   * @param fence A flag for controling std::memory_order.
+   * @return The pair of a read value and its word if any.
+   * @retval std::nullopt if a descriptor remains embedded.
+   * @note This function must be called in the scope of `CreateEpochGuard`.
+   */
+  template <class T>
+  static auto
+  TryRead(  //
+      void* const addr,
+      uint64_t& stalled,
+      const std::memory_order fence = std::memory_order_seq_cst)  //
+      -> std::optional<std::pair<T, T>>
+  {
+    static_assert(CanMwCAS<T>());
+
+    auto* const target_addr = static_cast<std::atomic_uint64_t*>(addr);
+    auto word = target_addr->load(fence);
+    while (word & kMwCASFlag) {
+      if (word & kRDCSSFlag) {
+        CompleteRDCSS(target_addr, word, fence);
+      } else if (word == stalled) {
+        if (!HelpStalled(target_addr, word, fence)) return std::nullopt;
+      } else if (!WaitForChange(target_addr, word, fence)) {
+        stalled = word;
+        return std::nullopt;
+      }
+    }
+    return std::pair{std::bit_cast<T>(word & kValueMask), std::bit_cast<T>(word)};
+  }
+
+  /**
+   * @brief Read values from given memory addresses at once.
+   *
+   * @tparam T An expected class of target fields.
+   * @param addrs Target memory addresses to read.
+   * @param[out] vals A buffer to store the pairs of a read value and its word.
+   * @param num The number of target addresses.
+   * @param fence A flag for controling std::memory_order.
+   * @note This function prefetches all the addresses before reading them so
+   * that their cache misses overlap.
+   */
+  template <class T>
+  static void
+  ReadBatch(  //
+      void* const* addrs,
+      std::pair<T, T>* vals,
+      const size_t num,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    BatchRead(addrs, vals, num, [fence](void* addr) { return Read<T>(addr, fence); });
+  }
+
   /**
    * @brief Add a new MwCAS target to this descriptor.
    *
+   * If other targets are in the same cache line, the new target is placed next
+   * to them in the address order. Then, adjacent 16-byte-aligned pairs of target
+   * words are embedded and finalized by single 16-byte CAS instructions.
+   *
    * @tparam T The class of a target word.
    * @param addr A target memory address.
    * @param old_val The expected value of a target field.
@@ -173,7 +305,7 @@ class alignas(kCacheLineSize) MwCASDescriptor
    * @param fence A flag for controling std::memory_order.
    */
   template <class T>
-  constexpr void
+  void
   AddMwCASTarget(  //
       void* const addr,
       const T old_val,
@@ -181,9 +313,64 @@ class alignas(kCacheLineSize) MwCASDescriptor
       const std::memory_order fence = std::memory_order_seq_cst)
   {
     static_assert(CanMwCAS<T>());
+    if constexpr (kPrefetchTargets) {
+      PrefetchForWrite(addr);
+    }
+
+    const auto pos = target_cnt_++;
+    if (pos >= kMwCASCapacity && !overflow_) {
+      overflow_ = std::make_unique<OverflowTargets>();
+    }
+    auto& target = (pos < kMwCASCapacity) ? targets_[pos] : overflow_->at(pos - kMwCASCapacity);
+    target.addr_and_fence = std::bit_cast<uint64_t>(addr) | static_cast<uint64_t>(fence);
+    target.old_val = std::bit_cast<uint64_t>(old_val);
+    target.new_val = std::bit_cast<uint64_t>(new_val);
+    if (pos > 0) {
+      PlaceNearSameLineTargets(pos);
+    }
+  }
 
-    new (&(targets_.at(target_cnt_++)))
-        MwCASTarget{static_cast<std::atomic_uint64_t*>(addr), old_val, new_val, fence};
+  /**
+   * @brief Add a new MwCAS target with a policy for reclaiming swapped pointers.
+   *
+   * When MwCAS completes, the pointer selected by a given policy (i.e., the old
+   * one on success or the new one on failure) is retired together with this
+   * descriptor, and it is released by `Deleter` when the GC reuses this
+   * descriptor. Thus, callers do not have to track which pointer to free.
+   *
+   * @tparam T The class of objects referred by a target field.
+   * @tparam Deleter A stateless deleter of `T` objects.
+   * @param addr A target memory address.
+   * @param old_val The expected value of a target field.
+   * @param new_val An inserting value into a target field.
+   * @param policy A policy for selecting a pointer to be reclaimed.
+   * @param fence A flag for controling std::memory_order.
+   * @note If this descriptor is discarded without calling MwCAS, no pointers
+   * are reclaimed.
+   */
+  template <class T, class Deleter = std::default_delete<T>>
+  void
+  AddMwCASTarget(  //
+      void* const addr,
+      T* const old_val,
+      T* const new_val,
+      const RecyclePolicy policy,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    static_assert(std::is_empty_v<Deleter> && std::is_default_constructible_v<Deleter>);
+
+    if (policy != kRecycleNever) {
+      if (!recycle_) {
+        recycle_ = std::make_unique<RecycleTargets>();
+      }
+      auto& target = recycle_->at(recycle_cnt_);
+      target.old_ptr = std::bit_cast<uint64_t>(old_val) & kValueMask;  // remove a version
+      target.new_ptr = std::bit_cast<uint64_t>(new_val);
+      target.policy = policy;
+      target.deleter = [](void* ptr) { Deleter{}(static_cast<T*>(ptr)); };
+      ++recycle_cnt_;
+    }
+    AddMwCASTarget(addr, old_val, new_val, fence);
   }
 
   /**
@@ -195,12 +382,42 @@ class alignas(kCacheLineSize) MwCASDescriptor
   auto MwCAS()  //
       -> bool;
 
+  /**
+   * @brief Perform independent MwCAS operations in a software-pipelined order.
+   *
+   * This function first prefetches the targets of all the descriptors, embeds
+   * them position by position across descriptors, and then decides and
+   * finalizes each operation. Thus, the cache misses of different operations
+   * overlap, while each operation is still atomic.
+   *
+   * @param descs Descriptors given by `GetDescriptor`.
+   * @param[out] results The results of the MwCAS operations.
+   * @param num The number of descriptors.
+   * @return The number of succeeded MwCAS operations.
+   * @note Operations in one batch should be independent. If they share target
+   * words, they may fail together even if they could succeed one by one, so
+   * retry such operations individually.
+   */
+  static auto MwCASBatch(  //
+      MwCASDescriptor* const* descs,
+      bool* results,
+      size_t num)  //
+      -> size_t;
+
  private:
+  /*##########################################################################*
+   * Friend classes
+   *##########################################################################*/
+
+  friend class CombiningMwCAS;
+  friend class WaitFreeMwCAS;
+  friend class DescriptorPool<MwCASDescriptor>;
+
   /*##########################################################################*
    * Type aliases
    *##########################################################################*/
 
-  using EpochBasedGC = ::dbgroup::memory::EpochBasedGC<MwCASDescriptor>;
+  using Pool = DescriptorPool<MwCASDescriptor>;
 
   /*##########################################################################*
    * Internal types
@@ -219,27 +436,88 @@ class alignas(kCacheLineSize) MwCASDescriptor
   /**
    * @brief A class for representing MwCAS targets.
    *
+   * Since target words are aligned to eight bytes, a fence to be inserted when
+   * embedding a descriptor is packed into the lower three bits of an address.
    */
-  struct alignas(kCacheLineSize / 2) MwCASTarget {
-    /// @brief A target memory address.
-    std::atomic_uint64_t* addr;
+  struct MwCASTarget {
+    /*########################################################################*
+     * Public getters
+     *########################################################################*/
+
+    /**
+     * @return A target memory address.
+     */
+    [[nodiscard]]
+    auto
+    Addr() const  //
+        -> std::atomic_uint64_t*
+    {
+      return std::bit_cast<std::atomic_uint64_t*>(addr_and_fence & ~kFenceMask);
+    }
+
+    /**
+     * @return A fence to be inserted when embedding a new value.
+     */
+    [[nodiscard]]
+    constexpr auto
+    Fence() const  //
+        -> std::memory_order
+    {
+      return static_cast<std::memory_order>(addr_and_fence & kFenceMask);
+    }
+
+    /*########################################################################*
+     * Public member variables
+     *########################################################################*/
+
+    /// @brief A target memory address and a fence in its lower bits.
+    uint64_t addr_and_fence;
 
     /// @brief An expected value of a target field.
     uint64_t old_val;
 
     /// @brief An inserting value into a target field.
     uint64_t new_val;
+  };
 
-    /// @brief A fence to be inserted when embedding a new value.
-    std::memory_order fence;
+  /// @brief An array for target entries beyond the capacity.
+  using OverflowTargets = std::array<MwCASTarget, kMaxTargetNum - kMwCASCapacity>;
+
+  /**
+   * @brief A class for representing pointers to be reclaimed after MwCAS.
+   *
+   */
+  struct RecycleTarget {
+    /// @brief The expected pointer of a target field.
+    uint64_t old_ptr;
+
+    /// @brief The inserting pointer into a target field.
+    uint64_t new_ptr;
+
+    /// @brief A policy for selecting a pointer (only a selected one after MwCAS).
+    RecyclePolicy policy;
+
+    /// @brief A function for releasing a pointer.
+    void (*deleter)(void*);
   };
 
+  /// @brief An array for pointers to be reclaimed.
+  using RecycleTargets = std::array<RecycleTarget, kMaxTargetNum>;
+
   /*##########################################################################*
    * Internal constants
    *##########################################################################*/
 
-  /// @brief The begin bit position of versions.
-  static constexpr uint64_t kVersionShift = kValueBitNum;
+  /// @brief The number of descriptors whose embedding is interleaved at once.
+  static constexpr size_t kPipelineDepth = 16;
+
+  /// @brief A bit mask for extracting fences from target addresses.
+  static constexpr uint64_t kFenceMask = alignof(std::atomic_uint64_t) - 1UL;
+
+  static_assert(static_cast<uint64_t>(std::memory_order_seq_cst) <= kFenceMask);
+
+  /// @brief The begin bit position of versions (or the MwCAS flag if unversioned).
+  static constexpr uint64_t kVersionShift = (kUnversionedValues) ? 63 : kValueBitNum;
 
   /// @brief A unit value for incrementing versions.
   static constexpr uint64_t kVersionUnit = 1UL << kVersionShift;
@@ -269,6 +547,65 @@ class alignas(kCacheLineSize) MwCASDescriptor
       uint64_t& word,
       std::memory_order fence);
 
+  /**
+   * @brief Complete an RDCSS operation embedded in a given word.
+   *
+   * @param[in] addr A target address.
+   * @param[in,out] word The current value of a target address.
+   * @param[in] fence A memory fence.
+   * @note The caller must be in the scope of `RDCSSDescriptor::CreateEpochGuard`
+   * if target words are shared with RDCSS.
+   */
+  static void CompleteRDCSS(  //
+      std::atomic_uint64_t* addr,
+      uint64_t& word,
+      std::memory_order fence);
+
+  /**
+   * @brief Spin and yield until an embedded descriptor is removed.
+   *
+   * @param[in] addr A target address.
+   * @param[in,out] word The current value of a target address.
+   * @param[in] fence A memory fence.
+   * @retval true if the word has been modified.
+   * @retval false otherwise.
+   */
+  static auto WaitForChange(  //
+      std::atomic_uint64_t* addr,
+      uint64_t& word,
+      std::memory_order fence)  //
+      -> bool;
+
+  /**
+   * @brief Help a stalled MwCAS embedded in a given word.
+   *
+   * @param[in] addr A target address.
+   * @param[in,out] word The current value of a target address.
+   * @param[in] fence A memory fence.
+   * @retval true if the stalled MwCAS has been helped or the word has changed.
+   * @retval false if the reference counter is saturated.
+   */
+  static auto HelpStalled(  //
+      std::atomic_uint64_t* addr,
+      uint64_t& word,
+      std::memory_order fence)  //
+      -> bool;
+
+  /**
+   * @param word A word with an embedded descriptor.
+   * @return The descriptor embedded in the given word.
+   */
+  static auto GetEmbeddedDescriptor(  //
+      uint64_t word)  //
+      -> MwCASDescriptor*;
+
+  /**
+   * @return The address (or index) of this descriptor with the flag.
+   */
+  [[nodiscard]]
+  auto GetBaseWord() const  //
+      -> uint64_t;
+
   /**
    * @brief Swap an embedded descriptor into a desired value.
    *
@@ -282,6 +619,170 @@ class alignas(kCacheLineSize) MwCASDescriptor
       uint64_t desired)     //
       -> bool;
 
+  /**
+   * @param pos The position of a target word.
+   * @return The target entry at the given position.
+   */
+  [[nodiscard]]
+  auto
+  GetTarget(  //
+      const size_t pos)  //
+      -> MwCASTarget&
+  {
+    if (pos < kMwCASCapacity) [[likely]] {
+      return targets_[pos];
+    }
+    return (*overflow_)[pos - kMwCASCapacity];
+  }
+
+  /**
+   * @param pos The position of a target word.
+   * @return The target entry at the given position.
+   */
+  [[nodiscard]]
+  auto
+  GetTarget(  //
+      const size_t pos) const  //
+      -> const MwCASTarget&
+  {
+    if (pos < kMwCASCapacity) [[likely]] {
+      return targets_[pos];
+    }
+    return (*overflow_)[pos - kMwCASCapacity];
+  }
+
+  /**
+   * @brief Move a new target next to registered targets in the same cache line.
+   *
+   * @param pos The position of a new target.
+   */
+  void PlaceNearSameLineTargets(  //
+      size_t pos);
+
+  /**
+   * @param pos The position of a target word.
+   * @retval true if the target and the next one can be swapped by a 16-byte CAS.
+   * @retval false otherwise.
+   */
+  [[nodiscard]]
+  auto IsCoalescable(  //
+      size_t pos) const  //
+      -> bool;
+
+  /**
+   * @retval true if any target word has been modified from its expected value.
+   * @retval false otherwise (i.e., this MwCAS may succeed).
+   * @note This function only reads target words, so it does not invalidate
+   * the cache lines of other threads.
+   */
+  [[nodiscard]]
+  auto HasStaleTarget() const  //
+      -> bool;
+
+  /**
+   * @brief Embed this descriptor into a target word.
+   *
+   * @param base_addr The address of this descriptor with the flag.
+   * @param pos The position of a target word.
+   * @retval true if the descriptor has been embedded by any thread.
+   * @retval false if the target word has a different value.
+   */
+  auto EmbedDescriptor(  //
+      uint64_t base_addr,
+      size_t pos)  //
+      -> bool;
+
+  /**
+   * @brief Embed this descriptor into two adjacent target words at once.
+   *
+   * @param base_addr The address of this descriptor with the flag.
+   * @param pos The position of the first target word.
+   * @retval true if the descriptor has been embedded into both the words.
+   * @retval false if either target word has a different value.
+   */
+  auto EmbedDescriptorPair(  //
+      uint64_t base_addr,
+      size_t pos)  //
+      -> bool;
+
+  /**
+   * @brief Swap this descriptor in two adjacent words into desired values at once.
+   *
+   * @param base_addr The address of this descriptor with the flag.
+   * @param pos The position of the first target word.
+   * @param desired_lo A desired value of the first target word.
+   * @param desired_hi A desired value of the second target word.
+   * @retval true if this descriptor may be referred by other threads.
+   * @retval false otherwise.
+   */
+  auto FinalizePair(  //
+      uint64_t base_addr,
+      size_t pos,
+      uint64_t desired_lo,
+      uint64_t desired_hi)  //
+      -> bool;
+
+  /**
+   * @brief Set a linearization point if this MwCAS is undecided.
+   *
+   * @param desired The status determined by this thread.
+   * @return The decided status.
+   */
+  auto Decide(  //
+      Status desired)  //
+      -> Status;
+
+  /**
+   * @brief Swap all the embedded descriptors into decided values.
+   *
+   * @param base_addr The address of this descriptor with the flag.
+   * @param succeeded A flag for indicating this MwCAS has succeeded.
+   * @retval true if this descriptor may be referred by other threads.
+   * @retval false otherwise.
+   */
+  auto FinalizeTargets(  //
+      uint64_t base_addr,
+      bool succeeded)  //
+      -> bool;
+
+  /**
+   * @brief Select pointers to be reclaimed according to the result of MwCAS.
+   *
+   * @param succeeded A flag for indicating this MwCAS has succeeded.
+   */
+  void SelectGarbage(  //
+      bool succeeded);
+
+  /**
+   * @brief Release the selected pointers.
+   *
+   * @note The descriptor pool calls this function before reusing retired
+   * descriptors.
+   */
+  void ReleaseGarbage();
+
+  /**
+   * @brief Return this descriptor to the pool after MwCAS.
+   *
+   * If this descriptor has pointers to be reclaimed, it is always retired so
+   * that the GC releases the pointers together with it.
+   *
+   * @param succeeded A flag for indicating this MwCAS has succeeded.
+   * @param referred A flag for indicating other threads may refer this.
+   */
+  void Release(  //
+      bool succeeded,
+      bool referred);
+
+  /**
+   * @brief Perform MwCAS by plain loads and stores in the exclusive mode.
+   *
+   * @retval true if all the target words have their expected values.
+   * @retval false otherwise.
+   */
+  auto MwCASExclusively()  //
+      -> bool;
+
   /**
    * @brief An actual MwCAS procedure.
    *
@@ -303,11 +804,20 @@ class alignas(kCacheLineSize) MwCASDescriptor
   /// @brief The number of registered MwCAS targets.
   size_t target_cnt_{};
 
+  /// @brief Target entries beyond the capacity, which are kept for reuse.
+  std::unique_ptr<OverflowTargets> overflow_{};
+
+  /// @brief The number of pointers to be reclaimed.
+  size_t recycle_cnt_{};
+
+  /// @brief Pointers to be reclaimed, which are kept for reuse.
+  std::unique_ptr<RecycleTargets> recycle_{};
+
   /// @brief Target entries of MwCAS.
   std::array<MwCASTarget, kMwCASCapacity> targets_ = {};
 
-  /// @brief A garbage collector for expired descriptors.
-  static inline std::unique_ptr<EpochBasedGC> _gc{};  // NOLINT
+  /// @brief The index of this descriptor in the descriptor table.
+  uint64_t index_{};
 };
 
 }  // namespace dbgroup::atomic::mwcas::lock_free
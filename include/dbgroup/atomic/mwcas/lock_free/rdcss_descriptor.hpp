@@ -0,0 +1,309 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_LOCK_FREE_RDCSS_DESCRIPTOR_HPP_
+#define DBGROUP_ATOMIC_MWCAS_LOCK_FREE_RDCSS_DESCRIPTOR_HPP_
+
+// C++ standard libraries
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// external C++ libraries
+#include <dbgroup/memory/utility.hpp>
+#include <dbgroup/thread/epoch_guard.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas::lock_free
+{
+// forward declaration for completing RDCSS in MwCAS
+class MwCASDescriptor;
+
+/**
+ * @brief A class for performing restricted double-compare single-swap (RDCSS).
+ *
+ * RDCSS swaps a target word only if the target word and a control word have
+ * their expected values. Only the target word is updated, so it is cheaper than
+ * MwCAS over the two words. Descriptors are reclaimed by an epoch-based GC.
+ *
+ * Descriptors are marked by `kMwCASFlag | kRDCSSFlag`, so target and control
+ * words can be shared with `MwCASDescriptor`: its `Read` completes embedded
+ * RDCSS, and this class reads MwCAS targets via `MwCASDescriptor::Read`. In
+ * that case, words are compared as a whole (i.e., including versions), and both
+ * `CreateEpochGuard` of this class and `MwCASDescriptor` must be held.
+ *
+ * @note Target words must be read via `Read` of this class (or that of
+ * `MwCASDescriptor`), and they must not be the control words of other RDCSS
+ * operations. As in MwCAS, neither target nor control values may use the most
+ * significant bit.
+ */
+class alignas(kCacheLineSize) RDCSSDescriptor
+{
+ public:
+  /*##########################################################################*
+   * GC settings
+   *##########################################################################*/
+
+  /// @brief The number of retained descriptors in each thread.
+  static constexpr size_t kMaxReusableDescriptors = 64;
+
+  /*##########################################################################*
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct an empty descriptor for RDCSS operations.
+   *
+   */
+  constexpr RDCSSDescriptor() = default;
+
+  RDCSSDescriptor(const RDCSSDescriptor&) = delete;
+  RDCSSDescriptor(RDCSSDescriptor&&) = delete;
+
+  auto operator=(const RDCSSDescriptor& obj) -> RDCSSDescriptor& = delete;
+  auto operator=(RDCSSDescriptor&&) -> RDCSSDescriptor& = delete;
+
+  /*##########################################################################*
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the RDCSSDescriptor object.
+   *
+   */
+  ~RDCSSDescriptor() = default;
+
+  /*##########################################################################*
+   * Public APIs for managing memory
+   *##########################################################################*/
+
+  /**
+   * @brief Start garbage collection for RDCSS descriptors.
+   *
+   * @param gc_interval Interval for GC in microseconds.
+   * @param gc_thread_num The number of worker threads to release garbages.
+   * @param reserved_num The number of descriptors to be pre-allocated.
+   * @note This function must be called before performing RDCSS.
+   */
+  static void StartGC(  //
+      size_t gc_interval = ::dbgroup::memory::kDefaultGCTime,
+      size_t gc_thread_num = ::dbgroup::memory::kDefaultGCThreadNum,
+      size_t reserved_num = kDefaultReservedDescNum);
+
+  /**
+   * @brief Stop garbage collection for RDCSS descriptors.
+   *
+   */
+  static void StopGC();
+
+  /**
+   * @return A guard instance for preventing GC.
+   */
+  static auto CreateEpochGuard()  //
+      -> ::dbgroup::thread::EpochGuard;
+
+  /*##########################################################################*
+   * Public utility functions
+   *##########################################################################*/
+
+  /**
+   * @brief Read a value from a given memory address.
+   *
+   * @tparam T An expected class of a target field.
+   * @param addr A target memory address to read.
+   * @param fence A flag for controling std::memory_order.
+   * @return A read value.
+   * @note If a memory address is included in RDCSS target fields, it must be
+   * read via this function.
+   * @note This function must be called in the scope of `CreateEpochGuard`
+   * because it may help an embedded descriptor.
+   */
+  template <class T>
+  static auto
+  Read(  //
+      const void* const addr,
+      const std::memory_order fence = std::memory_order_seq_cst)  //
+      -> T
+  {
+    static_assert(CanMwCAS<T>());
+
+    const auto* const target_addr = static_cast<const std::atomic_uint64_t*>(addr);
+    auto cur = target_addr->load(fence);
+    if (cur & kMwCASFlag) {
+      // found an incomplete RDCSS or MwCAS
+      cur = ReadEmbedded(target_addr, fence);
+    }
+
+    return std::bit_cast<T>(cur);
+  }
+
+  /**
+   * @brief Swap a target word if it and a control word have expected values.
+   *
+   * @tparam C The class of a control word.
+   * @tparam T The class of a target word.
+   * @param control_addr A control memory address.
+   * @param expected_control The expected value of a control field.
+   * @param addr A target memory address.
+   * @param old_val The expected value of a target field.
+   * @param new_val An inserting value into a target field.
+   * @param fence A flag for controling std::memory_order.
+   * @retval true if a RDCSS operation succeeds.
+   * @retval false otherwise.
+   * @note This function must be called in the scope of `CreateEpochGuard`.
+   */
+  template <class C, class T>
+  static auto
+  RDCSS(  //
+      const void* const control_addr,
+      const C expected_control,
+      void* const addr,
+      const T old_val,
+      const T new_val,
+      const std::memory_order fence = std::memory_order_seq_cst)  //
+      -> bool
+  {
+    static_assert(sizeof(C) == sizeof(uint64_t) && std::is_trivially_copyable_v<C>);
+    static_assert(CanMwCAS<T>());
+
+    auto* const desc = Pool::Get();
+    desc->control_addr_ = static_cast<const std::atomic_uint64_t*>(control_addr);
+    desc->expected_control_ = std::bit_cast<uint64_t>(expected_control);
+    desc->addr_ = static_cast<std::atomic_uint64_t*>(addr);
+    desc->old_val_ = std::bit_cast<uint64_t>(old_val);
+    desc->new_val_ = std::bit_cast<uint64_t>(new_val);
+    desc->fence_ = fence;
+    return desc->RDCSSInternal();
+  }
+
+ private:
+  /*##########################################################################*
+   * Friend classes
+   *##########################################################################*/
+
+  friend class MwCASDescriptor;
+
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using Pool = DescriptorPool<RDCSSDescriptor>;
+
+  /*##########################################################################*
+   * Internal types
+   *##########################################################################*/
+
+  /**
+   * @brief An enumeration for representing RDCSS status.
+   *
+   */
+  enum Status : uint64_t {
+    kUndecided = 0,
+    kSucceeded,
+    kFailed,
+  };
+
+  /*##########################################################################*
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief Flags for indicating RDCSS descriptors.
+  static constexpr uint64_t kDescFlags = kMwCASFlag | kRDCSSFlag;
+
+  /*##########################################################################*
+   * Internal utility functions
+   *##########################################################################*/
+
+  /**
+   * @param word A word with an embedded descriptor.
+   * @return The descriptor embedded in the given word.
+   */
+  static auto
+  GetEmbeddedDescriptor(  //
+      const uint64_t word)  //
+      -> RDCSSDescriptor*
+  {
+    return std::bit_cast<RDCSSDescriptor*>(word ^ kDescFlags);
+  }
+
+  /**
+   * @brief Read a word after completing embedded RDCSS and MwCAS operations.
+   *
+   * @param addr A target memory address.
+   * @param fence A flag for controling std::memory_order.
+   * @return A word without descriptors.
+   */
+  static auto ReadEmbedded(  //
+      const std::atomic_uint64_t* addr,
+      std::memory_order fence)  //
+      -> uint64_t;
+
+  /**
+   * @brief Embed this descriptor and complete RDCSS.
+   *
+   * @retval true if a RDCSS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto RDCSSInternal()  //
+      -> bool;
+
+  /**
+   * @brief Decide the result of this RDCSS by using the control word and swap
+   * the embedded descriptor into a new/old value.
+   *
+   * The control word is read via `MwCASDescriptor::Read` if a descriptor is
+   * embedded, so MwCAS targets can be control words.
+   *
+   * @retval true if a RDCSS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto Complete()  //
+      -> bool;
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief A control memory address.
+  const std::atomic_uint64_t* control_addr_{};
+
+  /// @brief The expected value of a control field.
+  uint64_t expected_control_{};
+
+  /// @brief A target memory address.
+  std::atomic_uint64_t* addr_{};
+
+  /// @brief The expected value of a target field.
+  uint64_t old_val_{};
+
+  /// @brief An inserting value into a target field.
+  uint64_t new_val_{};
+
+  /// @brief A fence to be inserted when embedding a new value.
+  std::memory_order fence_{};
+
+  /// @brief The status of this descriptor.
+  std::atomic<Status> stat_{kUndecided};
+};
+
+}  // namespace dbgroup::atomic::mwcas::lock_free
+
+#endif  // DBGROUP_ATOMIC_MWCAS_LOCK_FREE_RDCSS_DESCRIPTOR_HPP_
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_LOCK_FREE_WAIT_FREE_MWCAS_HPP_
+#define DBGROUP_ATOMIC_MWCAS_LOCK_FREE_WAIT_FREE_MWCAS_HPP_
+
+// C++ standard libraries
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// external C++ libraries
+#include <dbgroup/thread/id_manager.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas::lock_free
+{
+/**
+ * @brief A class for performing MwCAS operations in a wait-free manner.
+ *
+ * Each operation is first tried as a usual lock-free MwCAS. If it keeps failing,
+ * the operation is announced in a per-thread slot, and every thread helps the
+ * announced operations in round-robin order before starting its own one. Since
+ * the slot word is included in the targets of each helping MwCAS, an announced
+ * operation takes effect exactly once.
+ *
+ * @note This class uses descriptors of `MwCASDescriptor`, so its GC must be
+ * started in advance.
+ * @note The bounded number of steps (see `kMaxHelpNum`) holds only if all the
+ * writers of target words perform their operations via `Execute`. Plain MwCAS
+ * operations on the same words are still correct, but they may starve announced
+ * operations (i.e., the operations become lock-free).
+ */
+class WaitFreeMwCAS
+{
+ public:
+  /*##########################################################################*
+   * Public APIs
+   *##########################################################################*/
+
+  /**
+   * @brief Perform a MwCAS operation in a bounded number of steps.
+   *
+   * A given function reads target words via `MwCASDescriptor::Read` and
+   * registers MwCAS targets to a given descriptor. It may be called several
+   * times by several threads, so it must not have any other side effects.
+   *
+   * @tparam Func A class of functions with `bool(MwCASDescriptor*)`.
+   * @param func A function for preparing a MwCAS operation. It returns false
+   * if the operation should be aborted.
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false if the operation has been aborted.
+   */
+  template <class Func>
+  static auto
+  Execute(  //
+      const Func& func)  //
+      -> bool
+  {
+    const Operation op{&Invoke<Func>, &func};
+    HelpNext();
+
+    // fast path: perform usual lock-free MwCAS
+    for (size_t i = 0; i < kRetryNum; ++i) {
+      [[maybe_unused]] const auto& guard = MwCASDescriptor::CreateEpochGuard();
+      auto* const desc = MwCASDescriptor::GetDescriptor();
+      if (!func(desc)) {
+        MwCASDescriptor::Pool::Recycle(desc);
+        return false;
+      }
+      if (desc->MwCAS()) return true;
+    }
+
+    // slow path: announce this operation and get help from other threads
+    return Announce(op);
+  }
+
+ private:
+  /*##########################################################################*
+   * Internal types
+   *##########################################################################*/
+
+  /**
+   * @brief A class for representing type-erased operations.
+   *
+   */
+  struct Operation {
+    /// @brief A function for invoking a given operation.
+    bool (*invoke)(const void*, MwCASDescriptor*);
+
+    /// @brief A given operation.
+    const void* func;
+  };
+
+  /**
+   * @brief A class for representing announced operations of each thread.
+   *
+   */
+  struct alignas(kCacheLineSize) Slot {
+    /// @brief A MwCAS target word with a sequence number and status.
+    std::atomic_uint64_t state{0};
+
+    /// @brief A copy of the decided state, which is never a MwCAS target.
+    std::atomic_uint64_t status{0};
+
+    /// @brief An announced operation.
+    std::atomic<const Operation*> op{nullptr};
+
+    /// @brief The number of threads referring to the announced operation.
+    std::atomic_size_t helper_num{0};
+  };
+
+  /*##########################################################################*
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The status of announced operations in progress.
+  static constexpr uint64_t kPending = 0b01;
+
+  /// @brief The status of succeeded operations.
+  static constexpr uint64_t kSucceeded = 0b10;
+
+  /// @brief The status of aborted operations.
+  static constexpr uint64_t kAborted = 0b11;
+
+  /// @brief A bit mask for extracting status.
+  static constexpr uint64_t kStatusMask = 0b11;
+
+  /// @brief A unit value for incrementing sequence numbers.
+  static constexpr uint64_t kSeqUnit = 0b100;
+
+  /// @brief A bit mask for extracting sequence numbers in the value bits.
+  static constexpr uint64_t kSeqMask = ((1UL << kValueBitNum) - 1UL) ^ kStatusMask;
+
+  /**
+   * @brief The maximum number of helping MwCAS for one announced operation.
+   *
+   * A helping MwCAS fails only if another MwCAS on the same words succeeds. Each
+   * thread helps one slot before each of its operations, so it finishes at most
+   * `kMaxThreadCapacity` operations before it helps a given slot until the slot
+   * is decided, and after that it never interferes with the slot. Thus, if all
+   * the writers use `Execute`, the number of failures is at most the square of
+   * the number of threads.
+   */
+  static constexpr size_t kMaxHelpNum =
+      ::dbgroup::kMaxThreadCapacity * ::dbgroup::kMaxThreadCapacity;
+
+  /*##########################################################################*
+   * Internal utility functions
+   *##########################################################################*/
+
+  /**
+   * @tparam Func A class of functions with `bool(MwCASDescriptor*)`.
+   * @param func A type-erased function.
+   * @param desc A descriptor for preparing a MwCAS operation.
+   * @return The result of the given function.
+   */
+  template <class Func>
+  static auto
+  Invoke(  //
+      const void* func,
+      MwCASDescriptor* desc)  //
+      -> bool
+  {
+    return (*static_cast<const Func*>(func))(desc);
+  }
+
+  /**
+   * @brief Help an announced operation of the next slot in round-robin order.
+   *
+   */
+  static void HelpNext();
+
+  /**
+   * @brief Help an announced operation until it is completed.
+   *
+   * @param slot A target slot.
+   * @retval true if the operation has been decided.
+   * @retval false if helping MwCAS failed `kMaxHelpNum` times.
+   */
+  static auto Help(  //
+      Slot& slot)  //
+      -> bool;
+
+  /**
+   * @brief Announce a given operation and wait for its completion.
+   *
+   * @param op An operation to be announced.
+   * @retval true if the operation succeeds.
+   * @retval false if the operation has been aborted.
+   */
+  static auto Announce(  //
+      const Operation& op)  //
+      -> bool;
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief Announced operations of each thread.
+  static std::array<Slot, ::dbgroup::kMaxThreadCapacity> _slots;  // NOLINT
+
+  /// @brief The position of a slot to be helped next.
+  static inline thread_local size_t _help_pos{0};  // NOLINT
+};
+
+}  // namespace dbgroup::atomic::mwcas::lock_free
+
+#endif  // DBGROUP_ATOMIC_MWCAS_LOCK_FREE_WAIT_FREE_MWCAS_HPP_
@@ -0,0 +1,551 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DBGROUP_ATOMIC_MWCAS_PERSISTENT_MWCAS_DESCRIPTOR_HPP_
+#define DBGROUP_ATOMIC_MWCAS_PERSISTENT_MWCAS_DESCRIPTOR_HPP_
+
+// C++ standard libraries
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// local sources
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas::persistent
+{
+/**
+ * @brief A class to manage a crash-consistent MwCAS operation (PMwCAS).
+ *
+ * Descriptors and target words live in one memory-mapped file (a region), so
+ * they survive process crashes. A descriptor is persisted before it is embedded,
+ * and its decision is persisted before target words are finalized. Final values
+ * are written with a dirty flag, which is cleared after they are flushed, so
+ * readers never use values that may be lost by a crash. When a region is opened,
+ * every descriptor left in target words is rolled back if it was undecided, or
+ * rolled forward if it had succeeded.
+ *
+ * Descriptors are allocated in a region and embedded as their indices with
+ * generations, so a region can be mapped at different addresses after restart
+ * or by several processes (see `Attach`). This class follows the status machine
+ * of the lock-free MwCAS: if a thread finds that a descriptor in a target word
+ * is stalled, it aborts the descriptor if undecided or rolls it forward if
+ * succeeded, and then swaps its target words into decided values. Since values
+ * do not have versions, stalled descriptors are aborted instead of being
+ * embedded by helpers (as the lock-free MwCAS with `MWCAS_UNVERSIONED_VALUES`).
+ * Thus, a preempted or stopped owner (e.g., by SIGSTOP) does not block threads
+ * in any process. Each descriptor also records the process ID and start time of
+ * its owner, and descriptors reserved by dead processes are released by the
+ * others. Start times are compared to detect the reuse of process IDs.
+ *
+ * @note Target words must be placed in the root area of an opened region, and
+ * their values must fit in `kValueBitNum` bits.
+ */
+class alignas(kCacheLineSize) MwCASDescriptor
+{
+ public:
+  /*##########################################################################*
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct an empty descriptor for MwCAS operations.
+   *
+   */
+  constexpr MwCASDescriptor() = default;
+
+  MwCASDescriptor(const MwCASDescriptor&) = delete;
+  MwCASDescriptor(MwCASDescriptor&&) = delete;
+
+  auto operator=(const MwCASDescriptor& obj) -> MwCASDescriptor& = delete;
+  auto operator=(MwCASDescriptor&&) -> MwCASDescriptor& = delete;
+
+  /*##########################################################################*
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the MwCASDescriptor object.
+   *
+   */
+  ~MwCASDescriptor() = default;
+
+  /*##########################################################################*
+   * Public getters/setters
+   *##########################################################################*/
+
+  /**
+   * @return The number of registered MwCAS targets.
+   */
+  [[nodiscard]]
+  constexpr auto
+  Size() const  //
+      -> size_t
+  {
+    return target_cnt_;
+  }
+
+  /*##########################################################################*
+   * Public APIs for managing a persistent region
+   *##########################################################################*/
+
+  /**
+   * @brief Map a persistent region and recover incomplete MwCAS operations.
+   *
+   * If a given file does not exist, it is created with a given size. The region
+   * is mapped with `MAP_SYNC` if the file is on a DAX file system, and cache
+   * lines are written back by CLWB (or CLFLUSHOPT/CLFLUSH) and SFENCE. Otherwise,
+   * `msync` is used for persisting modified words.
+   *
+   * @param path The path of a backing file.
+   * @param size The size of a region in bytes if the file is created.
+   * @param desc_num The number of descriptors if the file is created.
+   * @retval true if the region has been mapped.
+   * @retval false otherwise (e.g., a region is already opened).
+   * @note This function must not be called concurrently with MwCAS.
+   */
+  static auto Open(  //
+      const std::string& path,
+      size_t size,
+      size_t desc_num = kDefaultReservedDescNum)  //
+      -> bool;
+
+  /**
+   * @brief Map a region in POSIX shared memory to share it between processes.
+   *
+   * A shared memory object is created and initialized under a file lock, so the
+   * other processes wait for the initialization. If a creator dies before
+   * finishing it, the next process initializes the object again. Since shared
+   * memory does not survive reboots, words are not written back in this mode,
+   * and descriptors left by crashed processes are completed by the surviving
+   * ones when they are found.
+   *
+   * @param name The name of a shared memory object (e.g., "/my_index").
+   * @param size The size of a region in bytes if the object is created.
+   * @param desc_num The number of descriptors if the object is created.
+   * @retval true if the region has been mapped.
+   * @retval false otherwise (e.g., a region is already opened).
+   * @note This function must not be called concurrently with MwCAS. The
+   * shared memory object is not removed by this class, so call `shm_unlink`
+   * when it is no longer needed.
+   */
+  static auto Attach(  //
+      const std::string& name,
+      size_t size,
+      size_t desc_num = kDefaultReservedDescNum)  //
+      -> bool;
+
+  /**
+   * @brief Persist and unmap the current region.
+   *
+   * @note All the MwCAS operations of this process must be completed before
+   * this function.
+   */
+  static void Close();
+
+  /**
+   * @return The head of the root area for target words in the current region.
+   */
+  [[nodiscard]]
+  static auto GetRoot()  //
+      -> void*;
+
+  /**
+   * @return The size of the root area in bytes.
+   */
+  [[nodiscard]]
+  static auto GetRootSize()  //
+      -> size_t;
+
+  /**
+   * @return A free descriptor in the current region.
+   * @note If all the descriptors are in use, this function waits for any of
+   * them to be released (or abandoned by crashed processes). If you do not call
+   * the MwCAS function, it is not reused.
+   */
+  [[nodiscard]]
+  static auto GetDescriptor()  //
+      -> MwCASDescriptor*;
+
+  /**
+   * @brief Write back given memory to the backing file.
+   *
+   * @param addr The head of memory in the current region.
+   * @param size The size of memory in bytes.
+   */
+  static void Persist(  //
+      const void* addr,
+      size_t size);
+
+  /*##########################################################################*
+   * Public utility functions
+   *##########################################################################*/
+
+  /**
+   * @brief Read a value from a given memory address.
+   *
+   * If a read word has a dirty flag, it is persisted before being returned.
+   *
+   * @tparam T An expected class of a target field.
+   * @param addr A target memory address to read.
+   * @param fence A flag for controling std::memory_order.
+   * @return A read value.
+   * @note If a memory address is included in MwCAS target fields, it must be
+   * read via this function.
+   */
+  template <class T>
+  static auto
+  Read(  //
+      void* const addr,
+      const std::memory_order fence = std::memory_order_seq_cst)  //
+      -> T
+  {
+    static_assert(CanMwCAS<T>());
+
+    auto* const target_addr = static_cast<std::atomic_uint64_t*>(addr);
+    auto word = target_addr->load(fence);
+    while (word & kMwCASFlag) {
+      FollowIfNeeded(target_addr, word, fence);
+    }
+    if (word & kDirtyFlag) {
+      word = CleanDirtyWord(target_addr, word);
+    }
+    return std::bit_cast<T>(word);
+  }
+
+  /**
+   * @brief Add a new MwCAS target to this descriptor.
+   *
+   * @tparam T The class of a target word.
+   * @param addr A target memory address in the root area.
+   * @param old_val The expected value of a target field.
+   * @param new_val An inserting value into a target field.
+   * @param fence A flag for controling std::memory_order.
+   */
+  template <class T>
+  void
+  AddMwCASTarget(  //
+      void* const addr,
+      const T old_val,
+      const T new_val,
+      const std::memory_order fence = std::memory_order_seq_cst)
+  {
+    static_assert(CanMwCAS<T>());
+    if constexpr (kPrefetchTargets) {
+      PrefetchForWrite(addr);
+    }
+
+    auto& target = targets_.at(target_cnt_++);
+    target.offset_and_fence = ToOffset(addr) | static_cast<uint64_t>(fence);
+    target.old_val = std::bit_cast<uint64_t>(old_val);
+    target.new_val = std::bit_cast<uint64_t>(new_val);
+  }
+
+  /**
+   * @brief Perform a MwCAS operation by using registered targets.
+   *
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   * @note The result of succeeded MwCAS is persisted before this function
+   * returns.
+   */
+  auto MwCAS()  //
+      -> bool;
+
+ private:
+  /*##########################################################################*
+   * Internal types
+   *##########################################################################*/
+
+  /**
+   * @brief An enumeration for representing MwCAS status.
+   *
+   * In addition to the status of the lock-free MwCAS, a persistent descriptor
+   * has `kFree` for indicating that it does not have to be recovered and
+   * `kReserved` for indicating that it is prepared by an owner. The generation
+   * of a descriptor is stored in the upper bits of a status word.
+   */
+  enum Status : uint64_t {
+    kUndecided = 0,
+    kSucceeded,
+    kFailed,
+    kFree,
+    kReserved,
+  };
+
+  /**
+   * @brief An enumeration for representing how to write back modified words.
+   *
+   */
+  enum PersistMode : uint64_t {
+    kNoPersist = 0,
+    kMsync,
+    kFlush,
+  };
+
+  /**
+   * @brief A class for representing MwCAS targets in a persistent region.
+   *
+   */
+  struct MwCASTarget {
+    /// @brief An offset of a target word and a fence in its lower bits.
+    uint64_t offset_and_fence;
+
+    /// @brief An expected value of a target field.
+    uint64_t old_val;
+
+    /// @brief An inserting value into a target field.
+    uint64_t new_val;
+  };
+
+  /*##########################################################################*
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The second bit from the last indicates values that may not be persisted.
+  /// @note Target words of this class are not shared with other descriptors, so
+  /// this bit does not conflict with `kDeadlockFreeFlag`.
+  static constexpr uint64_t kDirtyFlag = 1UL << 62UL;
+
+  /// @brief A bit mask for extracting fences from target offsets.
+  static constexpr uint64_t kFenceMask = alignof(std::atomic_uint64_t) - 1UL;
+
+  /// @brief The number of bits for descriptor indices in embedded words.
+  static constexpr uint64_t kIndexBitNum = 24;
+
+  /// @brief A bit mask for extracting descriptor indices from embedded words.
+  static constexpr uint64_t kIndexMask = (1UL << kIndexBitNum) - 1UL;
+
+  /// @brief A constant for incrementing the generations of descriptors.
+  static constexpr uint64_t kGenUnit = 1UL << kIndexBitNum;
+
+  /// @brief A bit mask for extracting generations from embedded and status words.
+  static constexpr uint64_t kGenMask = (kDirtyFlag - 1UL) ^ kIndexMask;
+
+  /// @brief A bit mask for extracting status from status words.
+  static constexpr uint64_t kStatusMask = kGenUnit - 1UL;
+
+  static_assert(kValueBitNum <= 62);
+  static_assert(static_cast<uint64_t>(std::memory_order_seq_cst) <= kFenceMask);
+
+  /*##########################################################################*
+   * Internal utility functions
+   *##########################################################################*/
+
+  /**
+   * @param addr A memory address in the current region.
+   * @return The offset of the address from the head of the region.
+   */
+  static auto
+  ToOffset(  //
+      const void* const addr)  //
+      -> uint64_t
+  {
+    return std::bit_cast<uint64_t>(addr) - std::bit_cast<uint64_t>(_base);
+  }
+
+  /**
+   * @param offset_and_fence An offset with a fence in its lower bits.
+   * @return The corresponding address in the current region.
+   */
+  static auto
+  ToAddr(  //
+      const uint64_t offset_and_fence)  //
+      -> std::atomic_uint64_t*
+  {
+    return std::bit_cast<std::atomic_uint64_t*>(_base + (offset_and_fence & ~kFenceMask));
+  }
+
+  /**
+   * @brief Map a backing file and initialize it if needed.
+   *
+   * @param fd The file descriptor of a backing file.
+   * @param is_new A flag for indicating the file has been created.
+   * @param size The size of a region.
+   * @param desc_num The number of descriptors if the file is created.
+   * @param mode The mode of writing back modified words.
+   * @retval true if the region has been mapped.
+   * @retval false otherwise.
+   */
+  static auto MapRegion(  //
+      int fd,
+      bool is_new,
+      size_t size,
+      size_t desc_num,
+      PersistMode mode)  //
+      -> bool;
+
+  /**
+   * @return The descriptors in the current region.
+   */
+  static auto GetDescriptors()  //
+      -> MwCASDescriptor*;
+
+  /**
+   * @brief Wait for a descriptor in a given word to be completed, or help it.
+   *
+   * @param addr A target address.
+   * @param word An embedded descriptor word, which is updated with a new word.
+   * @param fence A flag for controling std::memory_order.
+   */
+  static void FollowIfNeeded(  //
+      std::atomic_uint64_t* addr,
+      uint64_t& word,
+      std::memory_order fence);
+
+  /**
+   * @brief Abort or roll forward a stalled descriptor and swap its targets.
+   *
+   * @param desc_word An embedded descriptor word.
+   * @note Since the descriptor may be reused during helping, its targets are
+   * copied and validated by its status word before they are swapped.
+   */
+  static void HelpStalled(  //
+      uint64_t desc_word);
+
+  /**
+   * @brief Write back given target words.
+   *
+   * If words are written back by `msync`, they are persisted by one system call
+   * for the range between the first and the last targets.
+   *
+   * @param targets MwCAS targets.
+   * @param cnt The number of targets.
+   */
+  static void PersistTargets(  //
+      const MwCASTarget* targets,
+      size_t cnt);
+
+  /**
+   * @brief Swap an embedded descriptor into decided values durably.
+   *
+   * @param targets MwCAS targets.
+   * @param cnt The number of targets.
+   * @param desc_word An embedded descriptor word.
+   * @param succeeded A flag for indicating the MwCAS has succeeded.
+   */
+  static void FinalizeTargets(  //
+      const MwCASTarget* targets,
+      size_t cnt,
+      uint64_t desc_word,
+      bool succeeded);
+
+  /**
+   * @brief Persist a dirty word and remove its dirty flag.
+   *
+   * @param addr A target address.
+   * @param word The current dirty word.
+   * @return The word without the dirty flag.
+   */
+  static auto CleanDirtyWord(  //
+      std::atomic_uint64_t* addr,
+      uint64_t word)  //
+      -> uint64_t;
+
+  /**
+   * @brief Roll back or forward descriptors left in the current region.
+   *
+   * @return The number of recovered descriptors.
+   */
+  static auto Recover()  //
+      -> size_t;
+
+  /**
+   * @brief Swap this descriptor in target words into decided values.
+   *
+   * @param succeeded A flag for indicating this MwCAS has succeeded.
+   * @retval true if any target word has been recovered.
+   * @retval false otherwise.
+   * @note Target entries are validated since they may be partially written.
+   */
+  auto RecoverTargets(  //
+      bool succeeded)  //
+      -> bool;
+
+  /**
+   * @brief Take over and release this descriptor if its owner has died.
+   *
+   * @retval true if this descriptor has been released by this thread.
+   * @retval false otherwise.
+   */
+  auto ReleaseIfAbandoned()  //
+      -> bool;
+
+  /**
+   * @param stat A status word of this descriptor.
+   * @return A word for embedding this descriptor with the generation of `stat`.
+   */
+  [[nodiscard]]
+  auto GetDescWord(  //
+      uint64_t stat) const  //
+      -> uint64_t;
+
+  /**
+   * @brief Abort this descriptor if it has not been decided yet.
+   *
+   * @param stat The current status word, which is updated with a decided one.
+   */
+  void AbortIfUndecided(  //
+      uint64_t& stat);
+
+  /**
+   * @brief Embed a descriptor into a target word to linearlize MwCAS.
+   *
+   * @param desc_word The offset of this descriptor with a MwCAS flag.
+   * @param pos The position of a target word.
+   * @retval true if the descriptor is successfully embedded.
+   * @retval false otherwise.
+   */
+  auto EmbedDescriptor(  //
+      uint64_t desc_word,
+      size_t pos)  //
+      -> bool;
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The status of this descriptor with its generation.
+  std::atomic_uint64_t stat_{kFree};
+
+  /// @brief The process ID and start time of an owner (zero if this descriptor is free).
+  std::atomic_uint64_t owner_{0};
+
+  /// @brief The number of registered MwCAS targets.
+  size_t target_cnt_{};
+
+  /// @brief Target entries of MwCAS.
+  std::array<MwCASTarget, kMwCASCapacity> targets_ = {};
+
+  /// @brief The head of the current region.
+  static inline std::byte* _base{nullptr};  // NOLINT
+
+  /// @brief The size of the current region.
+  static inline size_t _size{0};  // NOLINT
+
+  /// @brief The mode of writing back modified words.
+  static inline PersistMode _persist_mode{kMsync};  // NOLINT
+
+  /// @brief The position of a descriptor to be checked next in each thread.
+  static inline thread_local size_t _desc_pos{0};  // NOLINT
+};
+
+}  // namespace dbgroup::atomic::mwcas::persistent
+
+#endif  // DBGROUP_ATOMIC_MWCAS_PERSISTENT_MWCAS_DESCRIPTOR_HPP_
@@ -24,6 +24,11 @@
 #include <cstdint>
 #include <type_traits>
 
+// system libraries
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
 namespace dbgroup::atomic::mwcas
 {
 /*############################################################################*
@@ -42,6 +47,25 @@ constexpr std::memory_order kRelaxed = std::memory_order_relaxed;
 /// @brief The last significant bit indicates MwCAS descriptors.
 constexpr uint64_t kMwCASFlag = 1UL << 63UL;
 
+/// @brief The second bit from the last indicates descriptors on threads' stacks.
+/// @note Such descriptors (i.e., deadlock-free ones) cannot be helped.
+constexpr uint64_t kDeadlockFreeFlag = 1UL << 62UL;
+
+/// @brief The third bit from the last indicates RDCSS descriptors with `kMwCASFlag`.
+/// @note This bit is meaningful only in descriptor words, so values can use it.
+constexpr uint64_t kRDCSSFlag = 1UL << 61UL;
+
+/**
+ * @brief An enumeration for representing the results of preparing MwCAS targets
+ * in coroutines.
+ *
+ */
+enum class Preparation : uint64_t {
+  kReady = 0,  // perform MwCAS with the registered targets
+  kRetry,      // back off and prepare targets again (e.g., a word is blocked)
+  kAbort,      // give up the operation
+};
+
 /*############################################################################*
  * Tuning parameters
  *############################################################################*/
@@ -61,6 +85,55 @@ constexpr size_t kRetryNum = (MWCAS_RETRY_THRESHOLD);
 /// @brief A sleep time for preventing busy loops [us].
 constexpr std::chrono::microseconds kBackOffTime{MWCAS_BACKOFF_TIME};
 
+/// @brief The maximum exponent of exponential back-off (i.e., up to 1024x sleep times).
+constexpr uint64_t kMaxBackOffShift = 10;
+
+#ifdef MWCAS_PREFETCH_TARGETS
+/// @brief Prefetch the cache lines of target words when they are registered.
+constexpr bool kPrefetchTargets = true;
+#else
+/// @brief Prefetch the cache lines of target words when they are registered.
+constexpr bool kPrefetchTargets = false;
+#endif
+
+#ifdef MWCAS_VALIDATE_TARGETS
+/// @brief Validate all the expected values before embedding descriptors.
+constexpr bool kValidateTargets = true;
+#else
+/// @brief Validate all the expected values before embedding descriptors.
+constexpr bool kValidateTargets = false;
+#endif
+
+#ifdef MWCAS_UNVERSIONED_VALUES
+/// @brief Use values without versions by aborting stalled lock-free MwCAS.
+constexpr bool kUnversionedValues = true;
+#else
+/// @brief Use values without versions by aborting stalled lock-free MwCAS.
+constexpr bool kUnversionedValues = false;
+#endif
+
+#if defined(MWCAS_DETECT_PREEMPTION) && defined(__linux__)
+/// @brief Roll back deadlock-free MwCAS if its thread is preempted while embedding.
+constexpr bool kDetectPreemption = true;
+#else
+/// @brief Roll back deadlock-free MwCAS if its thread is preempted while embedding.
+constexpr bool kDetectPreemption = false;
+#endif
+
+#ifdef MWCAS_USE_DESCRIPTOR_TABLE
+/// @brief Embed descriptor indices instead of descriptor addresses.
+constexpr bool kUseDescriptorTable = true;
+#else
+/// @brief Embed descriptor indices instead of descriptor addresses.
+constexpr bool kUseDescriptorTable = false;
+#endif
+
+/// @brief The size of memory chunks for descriptors (i.e., one huge page).
+constexpr size_t kDescChunkSize = 1UL << 21UL;
+
+/// @brief The default number of pre-allocated descriptors.
+constexpr size_t kDefaultReservedDescNum = 4096;
+
 /*############################################################################*
  * Global utility functions
  *############################################################################*/
@@ -79,6 +152,102 @@ CanMwCAS()  //
   return std::is_same_v<T, uint64_t> || std::is_pointer_v<T>;
 }
 
+/**
+ * @brief Prefetch a cache line to be read.
+ *
+ * @param addr An address in a target cache line.
+ */
+inline void
+PrefetchForRead(  //
+    const void* const addr)
+{
+  __builtin_prefetch(addr, 0, 3);
+}
+
+/**
+ * @brief Prefetch a cache line to be modified.
+ *
+ * @param addr An address in a target cache line.
+ */
+inline void
+PrefetchForWrite(  //
+    const void* const addr)
+{
+  __builtin_prefetch(addr, 1, 3);
+}
+
+/**
+ * @brief Read values from given memory addresses at once.
+ *
+ * This function prefetches all the addresses before reading them so that their
+ * cache misses overlap.
+ *
+ * @tparam Addr A class of target memory addresses.
+ * @tparam V A class of read values.
+ * @tparam ReadFunc A class of functions with `V(Addr)`.
+ * @param addrs Target memory addresses to read.
+ * @param[out] vals A buffer to store read values.
+ * @param num The number of target addresses.
+ * @param read A function for reading each address (e.g., `Read` of descriptors).
+ */
+template <class Addr, class V, class ReadFunc>
+void
+BatchRead(  //
+    const Addr* addrs,
+    V* vals,
+    const size_t num,
+    const ReadFunc& read)
+{
+  for (size_t i = 0; i < num; ++i) {
+    PrefetchForRead(addrs[i]);
+  }
+  for (size_t i = 0; i < num; ++i) {
+    vals[i] = read(addrs[i]);
+  }
+}
+
+/**
+ * @brief Compare loaded target words with their expected values at once.
+ *
+ * @param words The current words of MwCAS targets.
+ * @param expected The expected values of MwCAS targets.
+ * @param num The number of MwCAS targets.
+ * @retval true if any word differs from its expected value and does not contain
+ * a MwCAS descriptor (i.e., the MwCAS must fail).
+ * @retval false otherwise.
+ * @note This function uses AVX2/SSE4.1 instructions if they are available.
+ */
+inline auto
+HasStaleWord(  //
+    const uint64_t* words,
+    const uint64_t* expected,
+    const size_t num)  //
+    -> bool
+{
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 4 <= num; i += 4) {
+    const auto w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+    const auto e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(expected + i));
+    // the sign bit of each lane is set if it matches or has the MwCAS flag
+    const auto ok = _mm256_or_si256(_mm256_cmpeq_epi64(w, e), w);
+    if (_mm256_movemask_pd(_mm256_castsi256_pd(ok)) != 0b1111) return true;
+  }
+#endif
+#if defined(__SSE4_1__)
+  for (; i + 2 <= num; i += 2) {
+    const auto w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+    const auto e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expected + i));
+    const auto ok = _mm_or_si128(_mm_cmpeq_epi64(w, e), w);
+    if (_mm_movemask_pd(_mm_castsi128_pd(ok)) != 0b11) return true;
+  }
+#endif
+  for (; i < num; ++i) {
+    if (words[i] != expected[i] && (words[i] & kMwCASFlag) == 0) return true;
+  }
+  return false;
+}
+
 }  // namespace dbgroup::atomic::mwcas
 
 #endif  // DBGROUP_ATOMIC_MWCAS_UTILITY_HPP_
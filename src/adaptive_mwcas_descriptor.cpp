@@ -0,0 +1,140 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "dbgroup/atomic/mwcas/adaptive_mwcas_descriptor.hpp"
+
+// C++ standard libraries
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// local sources
+#include "dbgroup/atomic/mwcas/deadlock_free/mwcas_descriptor.hpp"
+#include "dbgroup/atomic/mwcas/lock_free/aopt_descriptor.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas
+{
+/*############################################################################*
+ * Static utilities
+ *############################################################################*/
+
+void
+AdaptiveMwCASDescriptor::StartGC(  //
+    const size_t gc_interval,
+    const size_t gc_thread_num,
+    const size_t reserved_num)
+{
+  lock_free::AOPTDescriptor::StartGC(gc_interval, gc_thread_num, reserved_num);
+}
+
+void
+AdaptiveMwCASDescriptor::StopGC()
+{
+  lock_free::AOPTDescriptor::StopGC();
+}
+
+auto
+AdaptiveMwCASDescriptor::CreateEpochGuard()  //
+    -> ::dbgroup::thread::EpochGuard
+{
+  return lock_free::AOPTDescriptor::CreateEpochGuard();
+}
+
+/*############################################################################*
+ * Public APIs
+ *############################################################################*/
+
+auto
+AdaptiveMwCASDescriptor::MwCAS()  //
+    -> bool
+{
+  const auto mode = _mode.load(kRelaxed);
+  bool succeeded{};
+  if (mode == kDeadlockFree) {
+    deadlock_free::MwCASDescriptor desc{};
+    for (size_t i = 0; i < target_cnt_; ++i) {
+      const auto& target = targets_[i];
+      // AOPT descriptors embedded before switching modes are not values
+      const auto word = static_cast<std::atomic_uint64_t*>(target.addr)->load(kRelaxed);
+      if ((word & (kMwCASFlag | kDeadlockFreeFlag)) == kMwCASFlag) {
+        lock_free::AOPTDescriptor::Finalize(target.addr);
+      }
+      desc.AddMwCASTarget(target.addr, target.old_val, target.new_val, target.fence);
+    }
+    succeeded = desc.MwCAS();
+  } else {
+    auto* const desc = lock_free::AOPTDescriptor::GetDescriptor();
+    for (size_t i = 0; i < target_cnt_; ++i) {
+      const auto& target = targets_[i];
+      desc->AddMwCASTarget(target.addr, target.old_val, target.new_val, target.fence);
+    }
+    succeeded = desc->MwCAS();
+  }
+
+  UpdateMode(mode, succeeded);
+  return succeeded;
+}
+
+/*############################################################################*
+ * Internal utilities
+ *############################################################################*/
+
+void
+AdaptiveMwCASDescriptor::UpdateMode(  //
+    const Mode mode,
+    const bool succeeded)
+{
+  thread_local size_t op_cnt = 0;
+  thread_local size_t fail_num = 0;
+  thread_local size_t stall_base = deadlock_free::MwCASDescriptor::GetStallCount();
+  fail_num += static_cast<size_t>(!succeeded);
+  if (++op_cnt < kWindowSize) return;
+
+  const auto stall_cnt = deadlock_free::MwCASDescriptor::GetStallCount();
+  const auto stall_num = stall_cnt - stall_base;
+  const auto failures = fail_num;
+  op_cnt = 0;
+  fail_num = 0;
+  stall_base = stall_cnt;
+
+  const auto window_num = _window_cnt.fetch_add(1, kRelaxed) + 1;
+  if (mode == kDeadlockFree) {
+    // switch to the lock-free mode if descriptors are often stalled
+    if (stall_num * kStallRatio <= kWindowSize) return;
+    auto expected = kDeadlockFree;
+    if (_mode.compare_exchange_strong(expected, kLockFree, kRelaxed, kRelaxed)) {
+      // stay longer if the last trial of the deadlock-free mode failed soon
+      const auto probation = _probation.load(kRelaxed);
+      _probation.store(
+          (window_num <= kMinProbation) ? std::min(probation * 2, kMaxProbation) : kMinProbation,
+          kRelaxed);
+      _fail_num.store(failures, kRelaxed);
+      _window_cnt.store(0, kRelaxed);
+    }
+  } else if (window_num >= _probation.load(kRelaxed)
+             || (window_num >= kMinProbation && failures > _fail_num.load(kRelaxed))) {
+    // try the deadlock-free mode again if AOPT does not reduce failures
+    auto expected = kLockFree;
+    if (_mode.compare_exchange_strong(expected, kDeadlockFree, kRelaxed, kRelaxed)) {
+      _window_cnt.store(0, kRelaxed);
+    }
+  }
+}
+
+}  // namespace dbgroup::atomic::mwcas
@@ -18,67 +18,187 @@
 #include "dbgroup/atomic/mwcas/deadlock_free/mwcas_descriptor.hpp"
 
 // C++ standard libraries
+#include <array>
 #include <atomic>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+
+// system libraries
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#if __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#endif
+#endif
 
 // external C++ libraries
 #include <dbgroup/lock/utility.hpp>
 
 // local sources
+#include "dbgroup/atomic/mwcas/exclusive_guard.hpp"
 #include "dbgroup/atomic/mwcas/utility.hpp"
 
 namespace dbgroup::atomic::mwcas::deadlock_free
 {
+#ifdef __linux__
+namespace
+{
+/*############################################################################*
+ * Local utility functions
+ *############################################################################*/
+
+/**
+ * @return The ID of the CPU that this thread is running on.
+ * @note If glibc has registered a rseq area for this thread, this function only
+ * reads its `cpu_id` field, which the kernel updates whenever this thread is
+ * migrated.
+ */
+auto
+GetCurrentCPU()  //
+    -> int64_t
+{
+#if __has_include(<sys/rseq.h>)
+  if (__rseq_size > 0) {
+    const auto* const area = reinterpret_cast<const struct rseq*>(  // NOLINT
+        static_cast<const char*>(__builtin_thread_pointer()) + __rseq_offset);
+    return *static_cast<const volatile uint32_t*>(&(area->cpu_id));
+  }
+#endif
+  return ::sched_getcpu();
+}
+
+/**
+ * @return The number of involuntary context switches of this thread.
+ * @note The CPU ID cannot detect preemption on the same CPU, so this counter is
+ * also checked at the cost of a system call.
+ */
+auto
+GetPreemptionCount()  //
+    -> int64_t
+{
+  ::rusage usage{};
+  ::getrusage(RUSAGE_THREAD, &usage);
+  return usage.ru_nivcsw;
+}
+
+}  // namespace
+#endif
 
 auto
 MwCASDescriptor::MwCAS()  //
     -> bool
 {
+  if (has_conflict_) return false;
+  if (ExclusiveGuard::IsActive()) [[unlikely]] {
+    return MwCASExclusively();
+  }
+
+  // abort without embedding if the expected values are already stale
+  if constexpr (kValidateTargets) {
+    if (HasStaleTarget()) return false;
+  }
+
   // serialize MwCAS operations by embedding a descriptor
-  const auto desc_addr = std::bit_cast<uint64_t>(this) | kMwCASFlag;
+  const auto desc_addr = std::bit_cast<uint64_t>(this) | kMwCASFlag | kDeadlockFreeFlag;
+#ifdef __linux__
+  [[maybe_unused]] const auto cpu = kDetectPreemption ? GetCurrentCPU() : 0;
+  [[maybe_unused]] const auto preempted = kDetectPreemption ? GetPreemptionCount() : 0;
+#endif
+  std::array<uint64_t, kMwCASCapacity> replaced{};
   auto mwcas_success = true;
   size_t embedded_count = 0;
   for (size_t i = 0; i < target_cnt_; ++i, ++embedded_count) {
-    if (!EmbedDescriptor(desc_addr, i)) {
+#ifdef __linux__
+    if constexpr (kDetectPreemption) {
+      // release the embedded descriptors if this thread has been preempted
+      if (i > 0 && (GetCurrentCPU() != cpu || GetPreemptionCount() != preempted)) {
+        ++_rollback_cnt;
+        mwcas_success = false;
+        break;
+      }
+    }
+#endif
+    if (!EmbedDescriptor(desc_addr, i, replaced[i])) {
       mwcas_success = false;
       break;
     }
   }
 
+  // give up MwCAS if any new word is invalid (e.g., a delta overflows)
+  std::array<uint64_t, kMwCASCapacity> desired{};
+  for (size_t i = 0; i < embedded_count && mwcas_success; ++i) {
+    desired[i] = GetNewWord(i, replaced[i]);
+    mwcas_success = (desired[i] & kMwCASFlag) == 0;
+  }
+
   // complete MwCAS
-  if (mwcas_success) {
-    for (size_t i = 0; i < embedded_count; ++i) {
-      auto& target = targets_[i];
-      target.addr->store(target.new_val, kRelaxed);
-    }
-  } else {
-    for (size_t i = 0; i < embedded_count; ++i) {
-      auto& target = targets_[i];
-      target.addr->store(target.old_val, kRelaxed);
-    }
+  for (size_t i = 0; i < embedded_count; ++i) {
+    addrs_[i]->store((mwcas_success) ? desired[i] : replaced[i], kRelaxed);
   }
 
   return mwcas_success;
 }
 
+auto
+MwCASDescriptor::MwCASExclusively()  //
+    -> bool
+{
+  std::array<uint64_t, kMwCASCapacity> desired{};
+  for (size_t i = 0; i < target_cnt_; ++i) {
+    const auto cur = addrs_[i]->load(kRelaxed);
+    if ((cur & masks_[i]) != (old_vals_[i] & masks_[i])) return false;
+    desired[i] = GetNewWord(i, cur);
+    if (desired[i] & kMwCASFlag) return false;
+  }
+  for (size_t i = 0; i < target_cnt_; ++i) {
+    addrs_[i]->store(desired[i], kRelaxed);
+  }
+  return true;
+}
+
+auto
+MwCASDescriptor::HasStaleTarget() const  //
+    -> bool
+{
+  for (size_t i = 0; i < target_cnt_; ++i) {
+    PrefetchForWrite(addrs_[i]);  // overlap cache misses
+  }
+  alignas(kCacheLineSize) std::array<uint64_t, kMwCASCapacity> words{};
+  alignas(kCacheLineSize) std::array<uint64_t, kMwCASCapacity> expected{};
+  for (size_t i = 0; i < target_cnt_; ++i) {
+    // keep MwCAS flags so that embedded descriptors are not regarded as stale
+    words[i] = addrs_[i]->load(kRelaxed) & (masks_[i] | kMwCASFlag);
+    expected[i] = old_vals_[i] & masks_[i];
+  }
+  return HasStaleWord(words.data(), expected.data(), target_cnt_);
+}
+
 auto
 MwCASDescriptor::EmbedDescriptor(  //
     const uint64_t desc_addr,
-    const size_t pos)  //
+    const size_t pos,
+    uint64_t& replaced)  //
     -> bool
 {
-  auto& target = targets_[pos];
-  auto* const addr = target.addr;
-  const auto old_val = target.old_val;
-  const auto fence = target.fence;
+  auto* const addr = addrs_[pos];
+  const auto mask = masks_[pos];
+  const auto old_bits = old_vals_[pos] & mask;
+  const auto fence = fences_[pos];
 
   for (size_t i = 1; true; ++i) {
     auto expected = addr->load(kRelaxed);
-    if (expected == old_val
+    if ((expected & kMwCASFlag) == 0 && (expected & mask) == old_bits
         && addr->compare_exchange_strong(expected, desc_addr, fence, kRelaxed)) {
+      replaced = expected;
       return true;
     }
-    if ((expected & kMwCASFlag) == 0 || i >= kRetryNum) break;
+    if ((expected & kMwCASFlag) == 0) break;
+    if (i >= kRetryNum) {
+      ++_stall_cnt;  // another descriptor has been embedded for a long time
+      break;
+    }
     CPP_UTILITY_SPINLOCK_HINT
   }
   return false;
@@ -24,13 +24,15 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <thread>
 #include <utility>
 
 // external C++ libraries
 #include <dbgroup/lock/utility.hpp>
-#include <dbgroup/memory/epoch_based_gc.hpp>
 
 // local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
+#include "dbgroup/atomic/mwcas/exclusive_guard.hpp"
 #include "dbgroup/atomic/mwcas/utility.hpp"
 
 namespace
@@ -59,30 +61,30 @@ namespace dbgroup::atomic::mwcas::lock_free
 void
 AOPTDescriptor::StartGC(  //
     const size_t gc_interval,
-    const size_t gc_thread_num)
+    const size_t gc_thread_num,
+    const size_t reserved_num)
 {
-  _gc = std::make_unique<EpochBasedGC>(gc_interval, gc_thread_num, kMaxReusableDescriptors);
+  Pool::StartGC(gc_interval, gc_thread_num, reserved_num);
 }
 
 void
 AOPTDescriptor::StopGC()
 {
-  _gc.reset();
+  Pool::StopGC();
 }
 
 auto
 AOPTDescriptor::CreateEpochGuard()  //
     -> ::dbgroup::thread::EpochGuard
 {
-  return _gc->CreateEpochGuard();
+  return Pool::CreateEpochGuard();
 }
 
 auto
 AOPTDescriptor::GetDescriptor()  //
     -> AOPTDescriptor*
 {
-  auto* const page = _gc->GetPageIfPossible<AOPTDescriptor>();
-  auto* const desc = (page == nullptr) ? new AOPTDescriptor{} : static_cast<AOPTDescriptor*>(page);
+  auto* const desc = Pool::Get();
   desc->target_cnt_ = 0;
   return desc;
 }
@@ -95,6 +97,10 @@ auto
 AOPTDescriptor::MwCAS()  //
     -> bool
 {
+  if (ExclusiveGuard::IsActive()) [[unlikely]] {
+    return MwCASExclusively();
+  }
+
   // set a memory fence
   stat_.store(kActive, kRelease);
   return MwCASInternal();
@@ -109,13 +115,23 @@ AOPTDescriptor::ReadInternal(  // NOLINT
 {
   uint64_t word{};
   uint64_t value{};
-  while (true) {
+  for (size_t i = 1; true; ++i) {
     word = addr->load(fence);
     if ((word & kMwCASFlag) == 0) {
       value = word;
       break;
     }
 
+    if (word & kDeadlockFreeFlag) {
+      // a deadlock-free descriptor cannot be helped, so wait for its completion
+      if (i > kRetryNum) {
+        std::this_thread::yield();
+      } else {
+        CPP_UTILITY_SPINLOCK_HINT
+      }
+      continue;
+    }
+
     // found a word descriptor
     auto* const desc = std::bit_cast<AOPTDescriptor*>(word & kPtrMask);
     const auto pos = (word & kCntMask) >> kCntPos;
@@ -133,6 +149,39 @@ AOPTDescriptor::ReadInternal(  // NOLINT
   return {word, value};
 }
 
+void
+AOPTDescriptor::Finalize(  //
+    void* const addr)
+{
+  auto* const target_addr = static_cast<std::atomic_uint64_t*>(addr);
+  while (true) {
+    // the read value is decided because other descriptors are helped
+    auto [word, value] = ReadInternal(target_addr, nullptr, kRelaxed);
+    if (word == value) return;
+    if (target_addr->compare_exchange_strong(word, value, kRelaxed, kRelaxed)) return;
+    CPP_UTILITY_SPINLOCK_HINT
+  }
+}
+
+auto
+AOPTDescriptor::MwCASExclusively()  //
+    -> bool
+{
+  // completed descriptors may remain in target words, so read logical values
+  auto succeeded = true;
+  for (size_t i = 0; i < target_cnt_ && succeeded; ++i) {
+    const auto& target = targets_[i];
+    succeeded = (ReadInternal(target.addr, this, kRelaxed).second == target.old_val);
+  }
+  for (size_t i = 0; i < target_cnt_ && succeeded; ++i) {
+    targets_[i].addr->store(targets_[i].new_val, kRelaxed);
+  }
+
+  // the descriptor has never been published, so it can be reused directly
+  Pool::Recycle(this);
+  return succeeded;
+}
+
 auto
 AOPTDescriptor::MwCASInternal(  // NOLINT
     const size_t begin_pos)     //
@@ -226,7 +275,7 @@ AOPTDescriptor::CompletedDescriptors::FinalizeCompletedDescriptors()
         target.addr->compare_exchange_strong(cur, target.old_val, kRelaxed, kRelaxed);
       }
     }
-    _gc->AddGarbage<AOPTDescriptor>(desc);
+    Pool::Retire(desc);
   }
   desc_num_ = 0;
 }
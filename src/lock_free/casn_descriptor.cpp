@@ -27,9 +27,10 @@
 
 // external C++ libraries
 #include <dbgroup/lock/utility.hpp>
-#include <dbgroup/memory/epoch_based_gc.hpp>
 
 // local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
+#include "dbgroup/atomic/mwcas/exclusive_guard.hpp"
 #include "dbgroup/atomic/mwcas/utility.hpp"
 
 namespace dbgroup::atomic::mwcas::lock_free
@@ -41,30 +42,30 @@ namespace dbgroup::atomic::mwcas::lock_free
 void
 CASNDescriptor::StartGC(  //
     const size_t gc_interval,
-    const size_t gc_thread_num)
+    const size_t gc_thread_num,
+    const size_t reserved_num)
 {
-  _gc = std::make_unique<EpochBasedGC>(gc_interval, gc_thread_num, kMaxReusableDescriptors);
+  Pool::StartGC(gc_interval, gc_thread_num, reserved_num);
 }
 
 void
 CASNDescriptor::StopGC()
 {
-  _gc.reset();
+  Pool::StopGC();
 }
 
 auto
 CASNDescriptor::CreateEpochGuard()  //
     -> ::dbgroup::thread::EpochGuard
 {
-  return _gc->CreateEpochGuard();
+  return Pool::CreateEpochGuard();
 }
 
 auto
 CASNDescriptor::GetDescriptor()  //
     -> CASNDescriptor*
 {
-  auto* const page = _gc->GetPageIfPossible<CASNDescriptor>();
-  auto* const desc = (page == nullptr) ? new CASNDescriptor{} : static_cast<CASNDescriptor*>(page);
+  auto* const desc = Pool::Get();
   desc->target_cnt_ = 0;
   return desc;
 }
@@ -77,10 +78,31 @@ auto
 CASNDescriptor::MwCAS()  //
     -> bool
 {
+  if (ExclusiveGuard::IsActive()) [[unlikely]] {
+    return MwCASExclusively();
+  }
+
   // set a memory fence
   stat_.store(kUndecided, kRelease);
   const auto succeeded = MwCASInternal();
-  _gc->AddGarbage<CASNDescriptor>(this);
+  Pool::Retire(this);
+  return succeeded;
+}
+
+auto
+CASNDescriptor::MwCASExclusively()  //
+    -> bool
+{
+  auto succeeded = true;
+  for (size_t i = 0; i < target_cnt_ && succeeded; ++i) {
+    succeeded = (targets_[i].addr->load(kRelaxed) == targets_[i].old_val);
+  }
+  for (size_t i = 0; i < target_cnt_ && succeeded; ++i) {
+    targets_[i].addr->store(targets_[i].new_val, kRelaxed);
+  }
+
+  // the descriptor has never been published, so it can be reused directly
+  Pool::Recycle(this);
   return succeeded;
 }
 
@@ -148,7 +170,7 @@ CASNDescriptor::RDCSS(  //
   auto& target = targets_[pos];
   auto cur = target.addr->load(kRelaxed);
   while (true) {
-    if (cur & kRDCSSFlag) {
+    if (cur & kRDCSSPhaseFlag) {
       CompleteRDCSS(cur);
       continue;
     }
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "dbgroup/atomic/mwcas/lock_free/combining_mwcas.hpp"
+
+// C++ standard libraries
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+// external C++ libraries
+#include <dbgroup/lock/utility.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas::lock_free
+{
+/*############################################################################*
+ * Static member variables
+ *############################################################################*/
+
+std::array<CombiningMwCAS::Shard, CombiningMwCAS::kShardNum> CombiningMwCAS::_shards{};  // NOLINT
+
+/*############################################################################*
+ * Internal utilities
+ *############################################################################*/
+
+auto
+CombiningMwCAS::Combine(  //
+    Shard& shard,
+    Request& req)  //
+    -> Status
+{
+  // publish the request
+  auto* head = shard.head.load(kRelaxed);
+  do {
+    req.next = head;
+  } while (!shard.head.compare_exchange_weak(head, &req, kRelease, kRelaxed));
+
+  for (size_t i = 1; !req.done.load(kAcquire); ++i) {
+    if (shard.combining.load(kRelaxed) || shard.combining.exchange(true, kAcquire)) {
+      // another thread is combining requests
+      if (i > kRetryNum) {
+        std::this_thread::yield();
+      } else {
+        CPP_UTILITY_SPINLOCK_HINT
+      }
+      continue;
+    }
+
+    // this thread is a combiner, so perform published requests
+    size_t req_num = 0;
+    for (auto* list = shard.head.exchange(nullptr, kAcquire); list != nullptr;
+         list = shard.head.exchange(nullptr, kAcquire)) {
+      // reverse the list to perform requests in the published order
+      Request* fifo = nullptr;
+      while (list != nullptr) {
+        auto* const next = list->next;
+        list->next = fifo;
+        fifo = list;
+        list = next;
+      }
+      while (fifo != nullptr) {
+        auto* const next = fifo->next;  // the request may be released after done
+        fifo->status = Apply(fifo->op);
+        fifo->done.store(true, kRelease);
+        fifo = next;
+        ++req_num;
+      }
+    }
+    if (req_num <= 1) {
+      // no other thread is contending, so return to usual MwCAS
+      shard.contention.store(0, kRelaxed);
+    }
+    shard.combining.store(false, kRelease);
+  }
+
+  return req.status;
+}
+
+auto
+CombiningMwCAS::Apply(  //
+    const Operation& op)  //
+    -> Status
+{
+  for (size_t i = 0; i < kRetryNum; ++i) {
+    [[maybe_unused]] const auto& guard = MwCASDescriptor::CreateEpochGuard();
+    auto* const desc = MwCASDescriptor::GetDescriptor();
+    if (!op.invoke(op.func, desc)) {
+      MwCASDescriptor::Pool::Recycle(desc);
+      return kAborted;
+    }
+    if (desc->MwCAS()) return kSucceeded;
+    CPP_UTILITY_SPINLOCK_HINT
+  }
+
+  // do not block the other requests by an operation that keeps failing
+  return kRetry;
+}
+
+}  // namespace dbgroup::atomic::mwcas::lock_free
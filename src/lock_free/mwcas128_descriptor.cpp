@@ -0,0 +1,257 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "dbgroup/atomic/mwcas/lock_free/mwcas128_descriptor.hpp"
+
+// C++ standard libraries
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+// external C++ libraries
+#include <dbgroup/lock/utility.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
+#include "dbgroup/atomic/mwcas/exclusive_guard.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+//                     Bit allocation of a word.
+//    |              127-64              |             63-0             |
+//    |         Metadata (meta)          |        Payload (val)         |
+
+//                   Bit allocation of metadata.
+// |     63     |       62-32       |      31-0      |
+// | MwCAS Flag | Reference Counter | Begin Position |  (embedded descriptors)
+// |     0      |            Version (62-0)          |  (payloads)
+
+namespace dbgroup::atomic::mwcas::lock_free
+{
+namespace
+{
+/*############################################################################*
+ * Local constants
+ *############################################################################*/
+
+/// @brief An offset for right-shifting to extract the "reference counter".
+constexpr uint64_t kCntShift = 32;
+
+/// @brief A constant for incrementing the "reference counter".
+constexpr uint64_t kCntUnit = 1UL << kCntShift;
+
+/// @brief A bitmask with only the "begin position" portion set to 1.
+constexpr uint64_t kPosMask = kCntUnit - 1UL;
+
+/// @brief A bitmask with only the "reference counter" portion set to 1.
+constexpr uint64_t kCntMask = (kMwCASFlag - 1UL) ^ kPosMask;
+
+/// @brief A bitmask for extracting versions.
+constexpr uint64_t kVersionMask = ~kMwCASFlag;
+
+}  // namespace
+
+/*############################################################################*
+ * Static utilities
+ *############################################################################*/
+
+void
+MwCAS128Descriptor::StartGC(  //
+    const size_t gc_interval,
+    const size_t gc_thread_num,
+    const size_t reserved_num)
+{
+  Pool::StartGC(gc_interval, gc_thread_num, reserved_num);
+}
+
+void
+MwCAS128Descriptor::StopGC()
+{
+  Pool::StopGC();
+}
+
+auto
+MwCAS128Descriptor::CreateEpochGuard()  //
+    -> ::dbgroup::thread::EpochGuard
+{
+  return Pool::CreateEpochGuard();
+}
+
+/*############################################################################*
+ * Public APIs
+ *############################################################################*/
+
+auto
+MwCAS128Descriptor::GetDescriptor()  //
+    -> MwCAS128Descriptor*
+{
+  auto* const desc = Pool::Get();
+  desc->target_cnt_ = 0;
+  return desc;
+}
+
+auto
+MwCAS128Descriptor::MwCAS()  //
+    -> bool
+{
+  if (ExclusiveGuard::IsActive()) [[unlikely]] {
+    return MwCASExclusively();
+  }
+
+  stat_.store(kUndecided, kRelease);  // set a memory fence
+  const auto [succeeded, referred] = MwCASInternal();
+  if (referred) {
+    Pool::Retire(this);
+  } else {
+    Pool::Recycle(this);
+  }
+  return succeeded;
+}
+
+/*############################################################################*
+ * Internal APIs
+ *############################################################################*/
+
+void
+MwCAS128Descriptor::FollowIfNeeded(  //
+    Word* const addr,
+    Word& word,
+    const std::memory_order fence)
+{
+  const auto another_word = word;
+  for (uint32_t i = 0; i < kRetryNum; ++i) {
+    CPP_UTILITY_SPINLOCK_HINT
+    word = Load(addr, fence);
+    if (word != another_word) return;
+  }
+  for (uint32_t i = 0; i < kRetryNum; ++i) {
+    std::this_thread::yield();
+    word = Load(addr, fence);
+    if (word != another_word) return;
+  }
+
+  const auto count = std::min((word.meta & kCntMask) >> kCntShift, kMaxBackOffShift);
+  std::this_thread::sleep_for(kBackOffTime * (1UL << count));  // exponential back-off
+
+  word = Load(addr, fence);
+  if (word != another_word) return;  // other threads modified this field
+
+  // a long CPU stall has been detected, so perform another MwCAS
+  const Word incremented{word.val, word.meta + kCntUnit};
+  if (CAS(addr, word, incremented, fence)) {
+    // follow another MwCAS
+    auto* const another_desc = std::bit_cast<MwCAS128Descriptor*>(word.val);
+    another_desc->MwCASInternal((word.meta & kPosMask) + 1);
+    word = Load(addr, fence);
+  }
+}
+
+auto
+MwCAS128Descriptor::Finalize(  //
+    MwCASTarget& target,       //
+    const Word desired)        //
+    -> bool
+{
+  const auto desc_addr = std::bit_cast<uint64_t>(this);
+  auto expected = Load(target.addr, kRelaxed);
+  while (true) {
+    if (expected.val != desc_addr || (expected.meta & kMwCASFlag) == 0) return true;
+    if (CAS(target.addr, expected, desired, kRelaxed)) {
+      return (expected.meta & kCntMask) != 0;
+    }
+    CPP_UTILITY_SPINLOCK_HINT
+  }
+}
+
+auto
+MwCAS128Descriptor::MwCASExclusively()  //
+    -> bool
+{
+  auto succeeded = true;
+  for (size_t i = 0; i < target_cnt_ && succeeded; ++i) {
+    succeeded = (Load(targets_[i].addr, kRelaxed) == targets_[i].old_word);
+  }
+  for (size_t i = 0; i < target_cnt_ && succeeded; ++i) {
+    const auto& target = targets_[i];
+    const auto ver = (target.old_word.meta + 1UL) & kVersionMask;
+    auto cur = Load(target.addr, kRelaxed);
+    while (!CAS(target.addr, cur, Word{target.new_val, ver}, kRelaxed)) {
+      // other threads do not modify target words in the exclusive mode
+    }
+  }
+
+  // the descriptor has never been published, so it can be reused directly
+  Pool::Recycle(this);
+  return succeeded;
+}
+
+auto
+MwCAS128Descriptor::MwCASInternal(  //
+    const size_t begin_pos)         //
+    -> std::pair<bool, bool>
+{
+  const auto desc_addr = std::bit_cast<uint64_t>(this);
+  auto cur_stat = stat_.load(kAcquire);  // set a memory fence for followers
+  if (cur_stat == kUndecided) {
+    auto stat = kSucceeded;
+    for (size_t i = begin_pos; i < target_cnt_; ++i) {
+      auto& target = targets_[i];
+      auto word = Load(target.addr, kRelaxed);
+
+      // try to embed the descriptor
+      if (word == target.old_word
+          && CAS(target.addr, word, Word{desc_addr, kMwCASFlag | i}, target.fence)) {
+        continue;
+      }
+
+      // check another thread has embedded the descriptor
+      if (word.val != desc_addr || (word.meta & kMwCASFlag) == 0) {
+        stat = kFailed;
+        break;
+      }
+    }
+
+    // set a linearization point
+    cur_stat = stat_.load(kRelaxed);
+    if (cur_stat == kUndecided
+        && stat_.compare_exchange_strong(cur_stat, stat, kRelaxed, kRelaxed)) {
+      cur_stat = stat;
+    }
+  }
+
+  const auto succeeded = (cur_stat == kSucceeded);
+  bool referred = false;
+  if (succeeded) {
+    for (size_t i = 0; i < target_cnt_; ++i) {
+      auto& target = targets_[i];
+      const auto ver = (target.old_word.meta + 1UL) & kVersionMask;
+      referred = Finalize(target, Word{target.new_val, ver}) || referred;
+    }
+  } else {
+    for (size_t i = 0; i < target_cnt_; ++i) {
+      auto& target = targets_[i];
+      referred = Finalize(target, target.old_word) || referred;
+    }
+  }
+
+  return std::pair{succeeded, referred};
+}
+
+}  // namespace dbgroup::atomic::mwcas::lock_free
@@ -18,6 +18,8 @@
 #include "dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp"
 
 // C++ standard libraries
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <bit>
 #include <cstddef>
@@ -28,18 +30,30 @@
 
 // external C++ libraries
 #include <dbgroup/lock/utility.hpp>
-#include <dbgroup/memory/epoch_based_gc.hpp>
 
 // local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
+#include "dbgroup/atomic/mwcas/exclusive_guard.hpp"
+#include "dbgroup/atomic/mwcas/lock_free/rdcss_descriptor.hpp"
 #include "dbgroup/atomic/mwcas/utility.hpp"
 
-//                       Bit allocation of a word.
-// |     63     |       62-50       |      49-47     |         46-0       |
-// | MwCAS Flag | Reference Counter | Begin Position | Descriptor Address |
+//                              Bit allocation of a word.
+// |     63     |   62-61  |       60-52       |      51-47     |         46-0       |
+// | MwCAS Flag | Reserved | Reference Counter | Begin Position | Descriptor Address |
+//
+//               Bit allocation of a word with MWCAS_USE_DESCRIPTOR_TABLE.
+// |     63     |   62-61  |     60-(N+6)      |    (N+5)-N     |        (N-1)-0     |
+// | MwCAS Flag | Reserved | Reference Counter | Begin Position |  Descriptor Index  |
+//
+// The reserved bits are set only in the words of deadlock-free and RDCSS descriptors.
 
 //                   Bit allocation of an actual value.
 //          |           63           |  62-(N+1) |     N-0      |
 //          | Version Confirmed Flag |  Version  | Actual Value |
+//
+//     Bit allocation of an actual value with MWCAS_UNVERSIONED_VALUES.
+//          |           63           |           62-0           |
+//          |       MwCAS Flag       |       Actual Value       |
 
 namespace dbgroup::atomic::mwcas::lock_free
 {
@@ -50,32 +64,74 @@ namespace
  *############################################################################*/
 
 /// @brief An offset for right-shifting to extract the "begin position".
-constexpr uint64_t kPosShift = 47;
+constexpr uint64_t kPosShift =
+    (kUseDescriptorTable) ? DescriptorPool<MwCASDescriptor>::kIndexBitNum : 47;
 
 /// @brief An offset for right-shifting to extract the "reference counter".
-constexpr uint64_t kCntShift = 50;
+constexpr uint64_t kCntShift = kPosShift + std::bit_width(MwCASDescriptor::kMaxTargetNum - 1);
 
 /// @brief A constant for incrementing the "reference counter".
 constexpr uint64_t kCntUnit = 1UL << kCntShift;
 
-/// @brief A bitmask with only the "descriptor address" portion set to 1.
-constexpr uint64_t kAddrMask = (1UL << 47UL) - 1UL;
+/// @brief A bitmask with only the "descriptor address/index" portion set to 1.
+constexpr uint64_t kAddrMask = (1UL << kPosShift) - 1UL;
 
 /// @brief A bitmask with only the "begin position" portion set to 1.
 constexpr uint64_t kPosMask = (kCntUnit - 1UL) ^ kAddrMask;
 
 /// @brief A bitmask with only the "reference counter" portion set to 1.
-constexpr uint64_t kCntMask = (kMwCASFlag - 1UL) ^ (kPosMask | kAddrMask);
+constexpr uint64_t kCntMask = (kRDCSSFlag - 1UL) ^ (kPosMask | kAddrMask);
 
-/// @brief A bitmask with only the "MwCAS FLAG" and "descriptor address" portions set to 1.
+static_assert((kCntMask >> kCntShift) > kMaxBackOffShift, "too few bits for reference counters");
+
+/// @brief A bitmask with only the "MwCAS FLAG" and "descriptor address/index" portions set to 1.
 constexpr uint64_t kDescMask = kMwCASFlag | kAddrMask;
 
+/// @brief A bitmask for extracting cache lines from addresses.
+constexpr uint64_t kLineMask = ~(kCacheLineSize - 1UL);
+
+#if defined(__x86_64__) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+/// @brief Swap adjacent target words by 16-byte CAS instructions.
+constexpr bool kCoalesceTargets = true;
+#else
+/// @brief Swap adjacent target words by 16-byte CAS instructions.
+constexpr bool kCoalesceTargets = false;
+#endif
+
 /*############################################################################*
- * Local global variable
+ * Local utility functions
  *############################################################################*/
 
-/// @brief A thread local descriptor for reuse.
-thread_local std::unique_ptr<MwCASDescriptor> _tls = nullptr;  // NOLINT
+/**
+ * @brief Swap two adjacent words by a 16-byte CAS instruction.
+ *
+ * @param addr The address of the first word, which must be aligned to 16 bytes.
+ * @param exp_lo An expected value of the first word.
+ * @param exp_hi An expected value of the second word.
+ * @param desired_lo A desired value of the first word.
+ * @param desired_hi A desired value of the second word.
+ * @retval true if both the words are swapped.
+ * @retval false otherwise.
+ * @note `cmpxchg16b` is a full memory barrier, so it satisfies any fence.
+ */
+auto
+CompareAndSwap16(  //
+    [[maybe_unused]] std::atomic_uint64_t* const addr,
+    [[maybe_unused]] const uint64_t exp_lo,
+    [[maybe_unused]] const uint64_t exp_hi,
+    [[maybe_unused]] const uint64_t desired_lo,
+    [[maybe_unused]] const uint64_t desired_hi)  //
+    -> bool
+{
+#if defined(__x86_64__) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+  using Word128 = unsigned __int128;
+  const auto expected = (static_cast<Word128>(exp_hi) << 64UL) | exp_lo;
+  const auto desired = (static_cast<Word128>(desired_hi) << 64UL) | desired_lo;
+  return __sync_bool_compare_and_swap(std::bit_cast<Word128*>(addr), expected, desired);
+#else
+  return false;
+#endif
+}
 
 }  // namespace
 
@@ -86,22 +142,23 @@ thread_local std::unique_ptr<MwCASDescriptor> _tls = nullptr;  // NOLINT
 void
 MwCASDescriptor::StartGC(  //
     const size_t gc_interval,
-    const size_t gc_thread_num)
+    const size_t gc_thread_num,
+    const size_t reserved_num)
 {
-  _gc = std::make_unique<EpochBasedGC>(gc_interval, gc_thread_num, kMaxReusableDescriptors);
+  Pool::StartGC(gc_interval, gc_thread_num, reserved_num);
 }
 
 void
 MwCASDescriptor::StopGC()
 {
-  _gc.reset();
+  Pool::StopGC();
 }
 
 auto
 MwCASDescriptor::CreateEpochGuard()  //
     -> ::dbgroup::thread::EpochGuard
 {
-  return _gc->CreateEpochGuard();
+  return Pool::CreateEpochGuard();
 }
 
 /*############################################################################*
@@ -112,12 +169,9 @@ auto
 MwCASDescriptor::GetDescriptor()  //
     -> MwCASDescriptor*
 {
-  auto* desc = _tls.release();
-  if (!desc) {
-    auto* const page = _gc->GetPageIfPossible<MwCASDescriptor>();
-    desc = (page) ? static_cast<MwCASDescriptor*>(page) : new MwCASDescriptor{};
-  }
+  auto* const desc = Pool::Get();
   desc->target_cnt_ = 0;
+  desc->recycle_cnt_ = 0;
   return desc;
 }
 
@@ -125,16 +179,98 @@ auto
 MwCASDescriptor::MwCAS()  //
     -> bool
 {
+  if (ExclusiveGuard::IsActive()) [[unlikely]] {
+    return MwCASExclusively();
+  }
+
+  if constexpr (kValidateTargets) {
+    // the descriptor has not been published yet, so it can be reused directly
+    if (HasStaleTarget()) {
+      Release(false, false);
+      return false;
+    }
+  }
+
   stat_.store(kUndecided, kRelease);  // set a memory fence
   const auto [succeeded, referred] = MwCASInternal();
-  if (referred) {
-    _gc->AddGarbage<MwCASDescriptor>(this);
-  } else {
-    _tls.reset(this);
-  }
+  Release(succeeded, referred);
   return succeeded;
 }
 
+auto
+MwCASDescriptor::MwCASBatch(  //
+    MwCASDescriptor* const* descs,
+    bool* results,
+    const size_t num)  //
+    -> size_t
+{
+  size_t succeeded_num = 0;
+  if (ExclusiveGuard::IsActive()) [[unlikely]] {
+    for (size_t i = 0; i < num; ++i) {
+      results[i] = descs[i]->MwCASExclusively();
+      succeeded_num += static_cast<size_t>(results[i]);
+    }
+    return succeeded_num;
+  }
+
+  std::array<MwCASDescriptor*, kPipelineDepth> active{};
+  std::array<size_t, kPipelineDepth> positions{};
+  std::array<Status, kPipelineDepth> stats{};
+  for (size_t begin = 0; begin < num; begin += kPipelineDepth) {
+    const auto end = std::min(begin + kPipelineDepth, num);
+
+    // prefetch all the targets to overlap cache misses
+    for (size_t i = begin; i < end; ++i) {
+      const auto* const desc = descs[i];
+      for (size_t j = 0; j < desc->target_cnt_; ++j) {
+        PrefetchForWrite(desc->GetTarget(j).Addr());
+      }
+    }
+
+    // exclude doomed operations before publishing descriptors
+    size_t active_num = 0;
+    size_t max_cnt = 0;
+    for (size_t i = begin; i < end; ++i) {
+      auto* const desc = descs[i];
+      results[i] = false;
+      if constexpr (kValidateTargets) {
+        if (desc->HasStaleTarget()) {
+          desc->Release(false, false);
+          continue;
+        }
+      }
+      desc->stat_.store(kUndecided, kRelease);  // set a memory fence
+      active[active_num] = desc;
+      positions[active_num] = i;
+      max_cnt = std::max(max_cnt, desc->target_cnt_);
+      stats[active_num++] = kSucceeded;
+    }
+
+    // embed descriptors position by position
+    for (size_t pos = 0; pos < max_cnt; ++pos) {
+      for (size_t i = 0; i < active_num; ++i) {
+        auto* const desc = active[i];
+        if (stats[i] != kSucceeded || pos >= desc->target_cnt_) continue;
+        if (!desc->EmbedDescriptor(desc->GetBaseWord(), pos)) {
+          stats[i] = kFailed;
+        }
+      }
+    }
+
+    // decide and complete each operation
+    for (size_t i = 0; i < active_num; ++i) {
+      auto* const desc = active[i];
+      const auto base_addr = desc->GetBaseWord();
+      const auto succeeded = (desc->Decide(stats[i]) == kSucceeded);
+      desc->Release(succeeded, desc->FinalizeTargets(base_addr, succeeded));
+      results[positions[i]] = succeeded;
+      succeeded_num += static_cast<size_t>(succeeded);
+    }
+  }
+
+  return succeeded_num;
+}
+
 /*############################################################################*
  * Internal APIs
  *############################################################################*/
@@ -144,34 +280,103 @@ MwCASDescriptor::FollowIfNeeded(  //
     std::atomic_uint64_t* const addr,
     uint64_t& word,
     const std::memory_order fence)
+{
+  if (word & kRDCSSFlag) {
+    CompleteRDCSS(addr, word, fence);
+    return;
+  }
+
+  const auto another_word = word;
+  if (WaitForChange(addr, word, fence)) return;
+
+  const auto count = std::min((word & kCntMask) >> kCntShift, kMaxBackOffShift);
+  std::this_thread::sleep_for(kBackOffTime * (1UL << count));  // exponential back-off
+
+  word = addr->load(fence);
+  if (word != another_word) return;  // other threads modified this field
+
+  // a long CPU stall has been detected, so perform another MwCAS
+  HelpStalled(addr, word, fence);
+}
+
+void
+MwCASDescriptor::CompleteRDCSS(  //
+    std::atomic_uint64_t* const addr,
+    uint64_t& word,
+    const std::memory_order fence)
+{
+  RDCSSDescriptor::GetEmbeddedDescriptor(word)->Complete();
+  CPP_UTILITY_SPINLOCK_HINT
+  word = addr->load(fence);
+}
+
+auto
+MwCASDescriptor::WaitForChange(  //
+    std::atomic_uint64_t* const addr,
+    uint64_t& word,
+    const std::memory_order fence)  //
+    -> bool
 {
   const auto another_word = word;
   for (uint32_t i = 0; i < kRetryNum; ++i) {
     CPP_UTILITY_SPINLOCK_HINT
     word = addr->load(fence);
-    if (word != another_word) return;
+    if (word != another_word) return true;
   }
   for (uint32_t i = 0; i < kRetryNum; ++i) {
     std::this_thread::yield();
     word = addr->load(fence);
-    if (word != another_word) return;
+    if (word != another_word) return true;
   }
+  return false;
+}
 
-  const auto count = (word & kCntMask) >> kCntShift;
-  std::this_thread::sleep_for(kBackOffTime * (1UL << count));  // exponential back-off
-
-  word = addr->load(fence);
-  if (word != another_word) return;  // other threads modified this field
-
-  // a long CPU stall has been detected, so perform another MwCAS
+auto
+MwCASDescriptor::HelpStalled(  //
+    std::atomic_uint64_t* const addr,
+    uint64_t& word,
+    const std::memory_order fence)  //
+    -> bool
+{
+  if ((word & kCntMask) == kCntMask) return false;  // keep waiting not to overflow the counter
   const auto incremented = word + kCntUnit;
   if (addr->compare_exchange_strong(word, incremented, kRelaxed, fence)) {
-    // follow another MwCAS
-    auto* const another_desc = std::bit_cast<MwCASDescriptor*>(word & kAddrMask);
-    const auto pos = (word & kPosMask) >> kPosShift;
-    another_desc->MwCASInternal(pos + 1);
+    auto* const another_desc = GetEmbeddedDescriptor(word);
+    if constexpr (kUnversionedValues) {
+      // abort another MwCAS because embedding it may cause ABA problems
+      const auto succeeded = (another_desc->Decide(kFailed) == kSucceeded);
+      another_desc->FinalizeTargets(another_desc->GetBaseWord(), succeeded);
+    } else {
+      // follow another MwCAS
+      const auto pos = (word & kPosMask) >> kPosShift;
+      another_desc->MwCASInternal(pos + 1);
+    }
     word = addr->load(fence);
   }
+  return true;
+}
+
+auto
+MwCASDescriptor::GetEmbeddedDescriptor(  //
+    const uint64_t word)  //
+    -> MwCASDescriptor*
+{
+  if constexpr (kUseDescriptorTable) {
+    return Pool::GetByIndex(word & kAddrMask);
+  } else {
+    return std::bit_cast<MwCASDescriptor*>(word & kAddrMask);
+  }
+}
+
+auto
+MwCASDescriptor::GetBaseWord() const  //
+    -> uint64_t
+{
+  if constexpr (kUseDescriptorTable) {
+    return index_ | kMwCASFlag;
+  } else {
+    return std::bit_cast<uint64_t>(this) | kMwCASFlag;
+  }
 }
 
 auto
@@ -181,70 +386,262 @@ MwCASDescriptor::Finalize(  //
     uint64_t desired)       //
     -> bool
 {
-  auto expected = target.addr->load(kRelaxed);
+  auto* const addr = target.Addr();
+  auto expected = addr->load(kRelaxed);
   while (true) {
     if (((expected ^ desc_addr) & kDescMask) != 0) return true;
-    if (target.addr->compare_exchange_weak(expected, desired, kRelaxed, kRelaxed)) {
+    if (addr->compare_exchange_weak(expected, desired, kRelaxed, kRelaxed)) {
       return (expected & kCntMask) != 0;
     }
     CPP_UTILITY_SPINLOCK_HINT
   }
 }
 
+auto
+MwCASDescriptor::FinalizePair(  //
+    const uint64_t base_addr,
+    const size_t pos,
+    const uint64_t desired_lo,
+    const uint64_t desired_hi)  //
+    -> bool
+{
+  auto& lo = GetTarget(pos);
+  auto& hi = GetTarget(pos + 1);
+  auto* const addr = lo.Addr();
+  const auto exp_lo = addr->load(kRelaxed);
+  const auto exp_hi = hi.Addr()->load(kRelaxed);
+  if (((exp_lo ^ base_addr) & kDescMask) == 0 && ((exp_hi ^ base_addr) & kDescMask) == 0
+      && CompareAndSwap16(addr, exp_lo, exp_hi, desired_lo, desired_hi)) {
+    return ((exp_lo | exp_hi) & kCntMask) != 0;
+  }
+
+  // the words have been modified, so finalize them one by one
+  const auto referred = Finalize(base_addr, lo, desired_lo);
+  return Finalize(base_addr, hi, desired_hi) || referred;
+}
+
+auto
+MwCASDescriptor::MwCASExclusively()  //
+    -> bool
+{
+  auto succeeded = true;
+  for (size_t i = 0; i < target_cnt_ && succeeded; ++i) {
+    const auto& target = GetTarget(i);
+    succeeded = (target.Addr()->load(kRelaxed) == target.old_val);
+  }
+  for (size_t i = 0; i < target_cnt_ && succeeded; ++i) {
+    const auto& target = GetTarget(i);
+    const auto ver = (target.old_val + kVersionUnit) & kVersionMask;
+    target.Addr()->store(target.new_val | ver, kRelaxed);
+  }
+
+  // the descriptor has never been published, so it can be reused directly
+  // and no other threads refer to the swapped pointers
+  SelectGarbage(succeeded);
+  ReleaseGarbage();
+  Pool::Recycle(this);
+  return succeeded;
+}
+
+void
+MwCASDescriptor::SelectGarbage(  //
+    const bool succeeded)
+{
+  const auto selected = (succeeded) ? kRecycleOldOnSuccess : kRecycleNewOnFailure;
+  for (size_t i = 0; i < recycle_cnt_; ++i) {
+    auto& target = (*recycle_)[i];
+    target.policy = static_cast<RecyclePolicy>(target.policy & selected);
+  }
+}
+
+void
+MwCASDescriptor::ReleaseGarbage()
+{
+  for (size_t i = 0; i < recycle_cnt_; ++i) {
+    const auto& target = (*recycle_)[i];
+    if (target.policy == kRecycleOldOnSuccess) {
+      target.deleter(std::bit_cast<void*>(target.old_ptr));
+    } else if (target.policy == kRecycleNewOnFailure) {
+      target.deleter(std::bit_cast<void*>(target.new_ptr));
+    }
+  }
+  recycle_cnt_ = 0;
+}
+
+void
+MwCASDescriptor::Release(  //
+    const bool succeeded,
+    const bool referred)
+{
+  if (recycle_cnt_ > 0) {
+    SelectGarbage(succeeded);
+    Pool::Retire(this);  // the GC releases the pointers with this descriptor
+  } else if (referred) {
+    Pool::Retire(this);
+  } else {
+    Pool::Recycle(this);
+  }
+}
+
+void
+MwCASDescriptor::PlaceNearSameLineTargets(  //
+    const size_t pos)
+{
+  // search the last target in the same cache line
+  const auto target = GetTarget(pos);
+  const auto addr = target.addr_and_fence & ~kFenceMask;
+  const auto line = addr & kLineMask;
+  auto dst = pos;
+  while (dst > 0 && (GetTarget(dst - 1).addr_and_fence & kLineMask) != line) {
+    --dst;
+  }
+  if (dst == 0) return;  // there is no target in the same cache line
+
+  // keep the address order in the cache line
+  while (dst > 0) {
+    const auto prev = GetTarget(dst - 1).addr_and_fence;
+    if ((prev & kLineMask) != line || (prev & ~kFenceMask) < addr) break;
+    --dst;
+  }
+  for (auto i = pos; i > dst; --i) {
+    GetTarget(i) = GetTarget(i - 1);
+  }
+  GetTarget(dst) = target;
+}
+
+auto
+MwCASDescriptor::IsCoalescable(  //
+    const size_t pos) const  //
+    -> bool
+{
+  if constexpr (kCoalesceTargets) {
+    if (pos + 1 >= target_cnt_) return false;
+    const auto lo = GetTarget(pos).addr_and_fence & ~kFenceMask;
+    const auto hi = GetTarget(pos + 1).addr_and_fence & ~kFenceMask;
+    return (lo & (2 * sizeof(uint64_t) - 1UL)) == 0 && hi == lo + sizeof(uint64_t);
+  } else {
+    return false;
+  }
+}
+
+auto
+MwCASDescriptor::HasStaleTarget() const  //
+    -> bool
+{
+  for (size_t i = 0; i < target_cnt_; ++i) {
+    PrefetchForWrite(GetTarget(i).Addr());  // overlap cache misses
+  }
+  alignas(kCacheLineSize) std::array<uint64_t, kMaxTargetNum> words{};
+  alignas(kCacheLineSize) std::array<uint64_t, kMaxTargetNum> expected{};
+  for (size_t i = 0; i < target_cnt_; ++i) {
+    const auto& target = GetTarget(i);
+    words[i] = target.Addr()->load(kRelaxed);
+    expected[i] = target.old_val;
+  }
+  return HasStaleWord(words.data(), expected.data(), target_cnt_);
+}
+
+auto
+MwCASDescriptor::EmbedDescriptor(  //
+    const uint64_t base_addr,
+    const size_t pos)  //
+    -> bool
+{
+  const auto desc_addr = base_addr | (pos << kPosShift);
+  auto& target = GetTarget(pos);
+  auto* const addr = target.Addr();
+  auto word = addr->load(kRelaxed);
+
+  // try to embed the descriptor
+  if (word == target.old_val
+      && addr->compare_exchange_strong(word, desc_addr, target.Fence(), kRelaxed)) {
+    return true;
+  }
+
+  // check another thread has embedded the descriptor
+  return (word & kDescMask) == base_addr;
+}
+
+auto
+MwCASDescriptor::EmbedDescriptorPair(  //
+    const uint64_t base_addr,
+    const size_t pos)  //
+    -> bool
+{
+  const auto& lo = GetTarget(pos);
+  const auto& hi = GetTarget(pos + 1);
+  if (CompareAndSwap16(lo.Addr(), lo.old_val, hi.old_val,  //
+                       base_addr | (pos << kPosShift), base_addr | ((pos + 1) << kPosShift))) {
+    return true;
+  }
+
+  // the words may have been embedded by other threads, so check them one by one
+  return EmbedDescriptor(base_addr, pos) && EmbedDescriptor(base_addr, pos + 1);
+}
+
+auto
+MwCASDescriptor::Decide(  //
+    const Status desired)  //
+    -> Status
+{
+  auto cur_stat = stat_.load(kRelaxed);
+  if (cur_stat == kUndecided
+      && stat_.compare_exchange_strong(cur_stat, desired, kRelaxed, kRelaxed)) {
+    cur_stat = desired;
+  }
+  return cur_stat;
+}
+
+auto
+MwCASDescriptor::FinalizeTargets(  //
+    const uint64_t base_addr,
+    const bool succeeded)  //
+    -> bool
+{
+  auto get_desired = [succeeded](const MwCASTarget& target) -> uint64_t {
+    if (succeeded) {
+      const auto ver = (target.old_val + kVersionUnit) & kVersionMask;
+      return target.new_val | ver;
+    }
+    return target.old_val & kVerAndValMask;
+  };
+
+  bool referred = false;
+  for (size_t i = 0; i < target_cnt_; ++i) {
+    auto& target = GetTarget(i);
+    if (IsCoalescable(i)) {
+      const auto desired_hi = get_desired(GetTarget(i + 1));
+      referred = FinalizePair(base_addr, i++, get_desired(target), desired_hi) || referred;
+    } else {
+      referred = Finalize(base_addr, target, get_desired(target)) || referred;
+    }
+  }
+  return referred;
+}
+
 auto
 MwCASDescriptor::MwCASInternal(  //
     const size_t begin_pos)      //
     -> std::pair<bool, bool>
 {
-  const auto base_addr = std::bit_cast<uint64_t>(this) | kMwCASFlag;
+  const auto base_addr = GetBaseWord();
   auto cur_stat = stat_.load(kAcquire);  // set a memory fence for followers
   if (cur_stat == kUndecided) {
     auto stat = kSucceeded;
     for (size_t i = begin_pos; i < target_cnt_; ++i) {
-      const auto desc_addr = base_addr | (i << kPosShift);
-      auto& target = targets_[i];
-      auto* const addr = target.addr;
-      const auto expected = target.old_val;
-      const auto fence = target.fence;
-      auto word = addr->load(kRelaxed);
-
-      // try to embed the descriptor
-      if (word == expected && addr->compare_exchange_strong(word, desc_addr, fence, kRelaxed)) {
-        continue;
-      }
-
-      // check another thread has embedded the descriptor
-      if ((word & kDescMask) != base_addr) {
+      const auto embedded = (IsCoalescable(i))  //
+                                ? EmbedDescriptorPair(base_addr, i++)
+                                : EmbedDescriptor(base_addr, i);
+      if (!embedded) {
         stat = kFailed;
         break;
       }
     }
-
-    // set a linearization point
-    cur_stat = stat_.load(kRelaxed);
-    if (cur_stat == kUndecided
-        && stat_.compare_exchange_strong(cur_stat, stat, kRelaxed, kRelaxed)) {
-      cur_stat = stat;
-    }
+    cur_stat = Decide(stat);  // set a linearization point
   }
 
   const auto succeeded = (cur_stat == kSucceeded);
-  bool referred = false;
-  if (succeeded) {
-    for (size_t i = 0; i < target_cnt_; ++i) {
-      auto& target = targets_[i];
-      const auto ver = (target.old_val + kVersionUnit) & kVersionMask;
-      referred = Finalize(base_addr, target, (target.new_val | ver)) || referred;
-    }
-  } else {
-    for (size_t i = 0; i < target_cnt_; ++i) {
-      auto& target = targets_[i];
-      const auto val = target.old_val & kVerAndValMask;
-      referred = Finalize(base_addr, target, val) || referred;
-    }
-  }
-
-  return std::pair{succeeded, referred};
+  return std::pair{succeeded, FinalizeTargets(base_addr, succeeded)};
 }
 
 }  // namespace dbgroup::atomic::mwcas::lock_free
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "dbgroup/atomic/mwcas/lock_free/rdcss_descriptor.hpp"
+
+// C++ standard libraries
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// local sources
+#include "dbgroup/atomic/mwcas/descriptor_pool.hpp"
+#include "dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas::lock_free
+{
+/*############################################################################*
+ * Static utilities
+ *############################################################################*/
+
+void
+RDCSSDescriptor::StartGC(  //
+    const size_t gc_interval,
+    const size_t gc_thread_num,
+    const size_t reserved_num)
+{
+  Pool::StartGC(gc_interval, gc_thread_num, reserved_num);
+}
+
+void
+RDCSSDescriptor::StopGC()
+{
+  Pool::StopGC();
+}
+
+auto
+RDCSSDescriptor::CreateEpochGuard()  //
+    -> ::dbgroup::thread::EpochGuard
+{
+  return Pool::CreateEpochGuard();
+}
+
+/*############################################################################*
+ * Internal utilities
+ *############################################################################*/
+
+auto
+RDCSSDescriptor::ReadEmbedded(  //
+    const std::atomic_uint64_t* const addr,
+    const std::memory_order fence)  //
+    -> uint64_t
+{
+  // MwCASDescriptor::Read completes both RDCSS and MwCAS descriptors
+  auto* const target_addr = const_cast<std::atomic_uint64_t*>(addr);  // NOLINT
+  return MwCASDescriptor::Read<uint64_t>(target_addr, fence).second;
+}
+
+auto
+RDCSSDescriptor::RDCSSInternal()  //
+    -> bool
+{
+  // set a memory fence
+  stat_.store(kUndecided, kRelease);
+
+  // embed this descriptor if the target word has the expected value
+  const auto desc_addr = std::bit_cast<uint64_t>(this) | kDescFlags;
+  auto cur = addr_->load(kRelaxed);
+  while (true) {
+    if (cur & kMwCASFlag) {
+      // help another RDCSS or MwCAS
+      cur = ReadEmbedded(addr_, kRelaxed);
+      continue;
+    }
+    if (cur != old_val_) {
+      // this descriptor has not been published, so reuse it immediately
+      Pool::Recycle(this);
+      return false;
+    }
+    if (addr_->compare_exchange_weak(cur, desc_addr, fence_, kRelaxed)) break;
+  }
+
+  const auto succeeded = Complete();
+  Pool::Retire(this);
+  return succeeded;
+}
+
+auto
+RDCSSDescriptor::Complete()  //
+    -> bool
+{
+  // the first thread that reads the control word decides the result
+  auto stat = stat_.load(kAcquire);
+  if (stat == kUndecided) {
+    auto control = control_addr_->load(kAcquire);
+    if (control & kMwCASFlag) {
+      // a raw descriptor word never matches, so read its logical value
+      control = ReadEmbedded(control_addr_, kAcquire);
+    }
+    const auto desired = (control == expected_control_) ? kSucceeded : kFailed;
+    if (stat_.compare_exchange_strong(stat, desired, kRelaxed, kRelaxed)) {
+      stat = desired;
+    }
+  }
+
+  const auto succeeded = (stat == kSucceeded);
+  auto expected = std::bit_cast<uint64_t>(this) | kDescFlags;
+  addr_->compare_exchange_strong(expected, succeeded ? new_val_ : old_val_, kRelaxed, kRelaxed);
+  return succeeded;
+}
+
+}  // namespace dbgroup::atomic::mwcas::lock_free
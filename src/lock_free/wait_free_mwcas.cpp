@@ -0,0 +1,121 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "dbgroup/atomic/mwcas/lock_free/wait_free_mwcas.hpp"
+
+// C++ standard libraries
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// external C++ libraries
+#include <dbgroup/lock/utility.hpp>
+#include <dbgroup/thread/id_manager.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp"
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+namespace dbgroup::atomic::mwcas::lock_free
+{
+/*############################################################################*
+ * Static member variables
+ *############################################################################*/
+
+std::array<WaitFreeMwCAS::Slot, ::dbgroup::kMaxThreadCapacity> WaitFreeMwCAS::_slots{};  // NOLINT
+
+/*############################################################################*
+ * Internal utilities
+ *############################################################################*/
+
+void
+WaitFreeMwCAS::HelpNext()
+{
+  auto& slot = _slots[_help_pos];
+  _help_pos = (_help_pos + 1) % _slots.size();
+  if ((slot.status.load(kAcquire) & kStatusMask) == kPending) {
+    Help(slot);
+  }
+}
+
+auto
+WaitFreeMwCAS::Help(  //
+    Slot& slot)  //
+    -> bool
+{
+  // prevent the owner from releasing the operation
+  slot.helper_num.fetch_add(1);
+  auto decided = false;
+  for (size_t i = 0; i < kMaxHelpNum; ++i) {
+    [[maybe_unused]] const auto& guard = MwCASDescriptor::CreateEpochGuard();
+    const auto [val, word] = MwCASDescriptor::Read<uint64_t>(&(slot.state));
+    if ((val & kStatusMask) != kPending) {
+      // publish the result via the word that never contains descriptors
+      auto pending = (val & kSeqMask) | kPending;
+      slot.status.compare_exchange_strong(pending, val, kRelease, kRelaxed);
+      decided = true;
+      break;
+    }
+    const auto* op = slot.op.load();
+    if (op == nullptr) {
+      decided = true;
+      break;
+    }
+
+    // the slot word ensures that only one helper completes the operation
+    auto* desc = MwCASDescriptor::GetDescriptor();
+    desc->AddMwCASTarget(&(slot.state), word, (val & kSeqMask) | kSucceeded);
+    if (!op->invoke(op->func, desc)) {
+      MwCASDescriptor::Pool::Recycle(desc);
+      desc = MwCASDescriptor::GetDescriptor();
+      desc->AddMwCASTarget(&(slot.state), word, (val & kSeqMask) | kAborted);
+    }
+    desc->MwCAS();
+  }
+  slot.helper_num.fetch_sub(1);
+  return decided;
+}
+
+auto
+WaitFreeMwCAS::Announce(  //
+    const Operation& op)  //
+    -> bool
+{
+  auto& slot = _slots[::dbgroup::thread::IDManager::GetThreadID()];
+  const auto seq = (slot.status.load(kRelaxed) + kSeqUnit) & kSeqMask;
+  slot.op.store(&op);
+  slot.state.store(seq | kPending);
+  slot.status.store(seq | kPending);
+
+  // help own operation together with other threads (helping gives up only if
+  // some writers bypass `Execute`, and then this operation becomes lock-free)
+  while (!Help(slot)) {
+    CPP_UTILITY_SPINLOCK_HINT
+  }
+  const auto stat = slot.status.load(kAcquire) & kStatusMask;
+
+  // wait for helpers to release the operation
+  slot.op.store(nullptr);
+  while (slot.helper_num.load() > 0) {
+    CPP_UTILITY_SPINLOCK_HINT
+  }
+
+  return stat == kSucceeded;
+}
+
+}  // namespace dbgroup::atomic::mwcas::lock_free
@@ -0,0 +1,757 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "dbgroup/atomic/mwcas/persistent/mwcas_descriptor.hpp"
+
+// C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// system libraries
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// external C++ libraries
+#include <dbgroup/lock/utility.hpp>
+
+// local sources
+#include "dbgroup/atomic/mwcas/utility.hpp"
+
+//                    Layout of a persistent region.
+// |  Header (one cache line)  |  Descriptors  |  Root area for target words  |
+
+//                       Bit allocation of a word.
+// |     63     |     62     |               61-0                |
+// | MwCAS Flag | Dirty Flag |           Actual Value            |
+//
+//                 Bit allocation of an embedded descriptor.
+// |     63     |     62     |      61-24      |      23-0       |
+// | MwCAS Flag |   Unused   |   Generation    | Descriptor Index |
+//
+//                    Bit allocation of a status word.
+// |         63-62           |      61-24      |      23-0       |
+// |         Unused          |   Generation    |     Status      |
+
+//                    Bit allocation of an owner word.
+// |              63-32                |              31-0              |
+// |       Start Time of a Process     |           Process ID           |
+
+namespace dbgroup::atomic::mwcas::persistent
+{
+namespace
+{
+/*############################################################################*
+ * Local types
+ *############################################################################*/
+
+/**
+ * @brief A class for representing the header of a persistent region.
+ *
+ */
+struct RegionHeader {
+  /// @brief A magic number for validating a region.
+  uint64_t magic;
+
+  /// @brief The size of a region.
+  uint64_t size;
+
+  /// @brief The number of descriptors in a region.
+  uint64_t desc_num;
+
+  /// @brief The offset of the root area.
+  uint64_t root_offset;
+};
+
+/*############################################################################*
+ * Local constants
+ *############################################################################*/
+
+/// @brief A magic number for persistent regions of MwCAS ("PMwCAS02").
+constexpr uint64_t kMagic = 0x3230534143774D50UL;
+
+/// @brief The offset of the first descriptor in a region.
+constexpr size_t kDescOffset = kCacheLineSize;
+
+/// @brief The begin bit position of process start times in owner words.
+constexpr uint64_t kStartTimeShift = 32;
+
+/// @brief A bit mask for extracting process IDs from owner words.
+constexpr uint64_t kPIDMask = (1UL << kStartTimeShift) - 1UL;
+
+/// @brief The position of a start time in `/proc/[pid]/stat` (see proc(5)).
+constexpr size_t kStartTimeField = 22;
+
+static_assert(sizeof(RegionHeader) <= kDescOffset);
+
+/*############################################################################*
+ * Local variables
+ *############################################################################*/
+
+/// @brief The cached owner word of this process.
+std::atomic_uint64_t owner_id = 0;  // NOLINT
+
+/*############################################################################*
+ * Local utility functions
+ *############################################################################*/
+
+/**
+ * @param base The head of a region.
+ * @return The header of the region.
+ */
+auto
+GetHeader(  //
+    std::byte* const base)  //
+    -> RegionHeader*
+{
+  return std::launder(reinterpret_cast<RegionHeader*>(base));
+}
+
+/**
+ * @brief Read the state and the start time of a given process.
+ *
+ * @param pid A process ID.
+ * @param state The state of the process (e.g., 'Z' for zombies).
+ * @param start_time The start time of the process after boot in clock ticks.
+ * @retval true if the process information has been read.
+ * @retval false otherwise (e.g., procfs is not available).
+ */
+auto
+ReadProcessStat(  //
+    const pid_t pid,
+    char& state,
+    uint64_t& start_time)  //
+    -> bool
+{
+  std::ifstream file{"/proc/" + std::to_string(pid) + "/stat"};
+  std::string line{};
+  if (!std::getline(file, line)) return false;
+
+  // a command name may include spaces, so skip it by the last parenthesis
+  const auto pos = line.rfind(')');
+  if (pos == std::string::npos) return false;
+  std::istringstream fields{line.substr(pos + 1)};
+  std::string field{};
+  fields >> state;
+  for (size_t i = 4; i < kStartTimeField; ++i) {
+    fields >> field;
+  }
+  fields >> start_time;
+  return !fields.fail();
+}
+
+/**
+ * @return The owner word of this process, which consists of its ID and start time.
+ * @note The cached word is reset in child processes by a fork handler.
+ */
+auto
+GetOwnerID()  //
+    -> uint64_t
+{
+  [[maybe_unused]] static const auto registered =
+      ::pthread_atfork(nullptr, nullptr, [] { owner_id.store(0, kRelaxed); });
+
+  auto id = owner_id.load(kRelaxed);
+  if (id == 0) {
+    const auto pid = ::getpid();
+    char state{};
+    uint64_t start_time = 0;
+    ReadProcessStat(pid, state, start_time);
+    id = (start_time << kStartTimeShift) | static_cast<uint64_t>(pid);
+    owner_id.store(id, kRelaxed);
+  }
+  return id;
+}
+
+/**
+ * @param owner An owner word.
+ * @retval true if the owner process may be alive.
+ * @retval false if the owner process has terminated.
+ * @note Process IDs can be reused by other processes, so start times are also
+ * compared. Zombie processes are regarded as terminated ones.
+ */
+auto
+IsAlive(  //
+    const uint64_t owner)  //
+    -> bool
+{
+  const auto pid = static_cast<pid_t>(owner & kPIDMask);
+  if (::kill(pid, 0) != 0 && errno == ESRCH) return false;
+
+  char state{};
+  uint64_t start_time = 0;
+  if (!ReadProcessStat(pid, state, start_time)) return true;  // cannot check reuse
+  if (state == 'Z') return false;
+  const auto owner_start = owner >> kStartTimeShift;
+  return owner_start == 0 || owner_start == (start_time & kPIDMask);
+}
+
+/**
+ * @brief Write back cache lines in a given range without store fences.
+ *
+ * @param begin The begin address of the range.
+ * @param end The end address of the range.
+ */
+void
+WriteBackLines(  //
+    [[maybe_unused]] const uint64_t begin,
+    [[maybe_unused]] const uint64_t end)
+{
+#if defined(__x86_64__)
+  for (auto line = begin & ~(kCacheLineSize - 1UL); line < end; line += kCacheLineSize) {
+#if defined(__CLWB__)
+    _mm_clwb(std::bit_cast<void*>(line));
+#elif defined(__CLFLUSHOPT__)
+    _mm_clflushopt(std::bit_cast<void*>(line));
+#else
+    _mm_clflush(std::bit_cast<void*>(line));
+#endif
+  }
+#endif
+}
+
+/**
+ * @brief Wait for written-back cache lines to be persisted.
+ *
+ */
+void
+StoreFence()
+{
+#if defined(__x86_64__)
+  _mm_sfence();
+#endif
+}
+
+}  // namespace
+
+/*############################################################################*
+ * Public APIs for managing a persistent region
+ *############################################################################*/
+
+auto
+MwCASDescriptor::Open(  //
+    const std::string& path,
+    size_t size,
+    const size_t desc_num)  //
+    -> bool
+{
+  if (_base != nullptr) return false;
+
+  const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);  // NOLINT
+  if (fd < 0) return false;
+
+  // prepare a backing file
+  struct stat st{};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+  const auto is_new = (st.st_size == 0);
+  if (!is_new) {
+    size = static_cast<size_t>(st.st_size);
+  }
+
+  // map the file directly to persistent memory if possible
+  auto mapped = false;
+#if defined(__x86_64__) && defined(MAP_SYNC) && defined(MAP_SHARED_VALIDATE)
+  mapped = MapRegion(fd, is_new, size, desc_num, kFlush);
+#endif
+  if (!mapped) {
+    mapped = MapRegion(fd, is_new, size, desc_num, kMsync);
+  }
+  ::close(fd);
+  if (!mapped) return false;
+
+  // a region must have been initialized by this process or before restart
+  auto* const header = GetHeader(_base);
+  if (std::atomic_ref{header->magic}.load(kAcquire) != kMagic || header->size != size) {
+    Close();
+    return false;
+  }
+
+  Recover();
+  return true;
+}
+
+auto
+MwCASDescriptor::Attach(  //
+    const std::string& name,
+    size_t size,
+    const size_t desc_num)  //
+    -> bool
+{
+  if (_base != nullptr) return false;
+
+  const auto fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);  // NOLINT
+  if (fd < 0) return false;
+
+  // initialize the shared memory exclusively; a file lock is released even if
+  // its holder dies, so other processes never wait for a dead creator
+  struct stat st{};
+  if (::flock(fd, LOCK_EX) != 0 || ::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+  const auto is_new = (st.st_size == 0);
+  if (!is_new) {
+    size = static_cast<size_t>(st.st_size);
+  }
+  auto mapped = MapRegion(fd, is_new, size, desc_num, kNoPersist);
+  if (mapped && !is_new && std::atomic_ref{GetHeader(_base)->magic}.load(kAcquire) != kMagic) {
+    // the creator has died before publishing the region, so initialize it again
+    Close();
+    mapped = MapRegion(fd, true, size, desc_num, kNoPersist);
+  }
+
+  // a mapped region keeps the file open, so the lock must be released explicitly
+  ::flock(fd, LOCK_UN);
+  ::close(fd);
+  return mapped;
+}
+
+void
+MwCASDescriptor::Close()
+{
+  if (_base == nullptr) return;
+
+  if (_persist_mode != kNoPersist) {
+    ::msync(_base, _size, MS_SYNC);
+  }
+  ::munmap(_base, _size);
+  _base = nullptr;
+  _size = 0;
+}
+
+auto
+MwCASDescriptor::GetRoot()  //
+    -> void*
+{
+  return _base + GetHeader(_base)->root_offset;
+}
+
+auto
+MwCASDescriptor::GetRootSize()  //
+    -> size_t
+{
+  return _size - GetHeader(_base)->root_offset;
+}
+
+auto
+MwCASDescriptor::GetDescriptor()  //
+    -> MwCASDescriptor*
+{
+  auto* const descs = GetDescriptors();
+  const auto desc_num = GetHeader(_base)->desc_num;
+  const auto owner = GetOwnerID();
+  for (size_t i = 1; true; ++i) {
+    if (_desc_pos >= desc_num) {
+      _desc_pos = 0;
+    }
+    auto& desc = descs[_desc_pos++];
+    if (i > desc_num) {
+      desc.ReleaseIfAbandoned();  // all the descriptors were in use
+    }
+    uint64_t expected = 0;
+    if (desc.owner_.load(kRelaxed) == 0
+        && desc.owner_.compare_exchange_strong(expected, owner, kAcquire, kRelaxed)) {
+      // descriptors are freed before their owners are cleared
+      const auto gen = desc.stat_.load(kRelaxed) & kGenMask;
+      desc.stat_.store(gen | kReserved, kRelaxed);
+      desc.target_cnt_ = 0;
+      return &desc;
+    }
+    if (i % desc_num == 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void
+MwCASDescriptor::Persist(  //
+    const void* const addr,
+    const size_t size)
+{
+  const auto begin = std::bit_cast<uint64_t>(addr);
+  const auto end = begin + size;
+  if (_persist_mode == kNoPersist) return;
+  if (_persist_mode == kMsync) {
+    static const auto page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+    const auto head = begin & ~(page_size - 1UL);
+    ::msync(std::bit_cast<void*>(head), end - head, MS_SYNC);
+    return;
+  }
+
+  WriteBackLines(begin, end);
+  StoreFence();
+}
+
+/*############################################################################*
+ * Public utility functions
+ *############################################################################*/
+
+auto
+MwCASDescriptor::MwCAS()  //
+    -> bool
+{
+  // persist the targets of this descriptor before publishing it
+  const auto gen = stat_.load(kRelaxed) & kGenMask;
+  stat_.store(gen | kUndecided, kRelease);
+  Persist(this, sizeof(MwCASDescriptor));
+
+  // serialize MwCAS operations by embedding a descriptor
+  const auto desc_word = GetDescWord(gen);
+  auto mwcas_success = true;
+  size_t embedded_num = 0;
+  for (; embedded_num < target_cnt_; ++embedded_num) {
+    if (!EmbedDescriptor(desc_word, embedded_num)) {
+      mwcas_success = false;
+      break;
+    }
+  }
+
+  if (mwcas_success) {
+    // embedded descriptors must be durable before the decision is persisted
+    PersistTargets(targets_.data(), target_cnt_);
+  }
+  auto stat = gen | kUndecided;
+  const auto decided = gen | ((mwcas_success) ? kSucceeded : kFailed);
+  if (!stat_.compare_exchange_strong(stat, decided, kRelaxed, kRelaxed)) {
+    mwcas_success = false;  // another thread has aborted this MwCAS
+  } else if (mwcas_success) {
+    // a failure need not be persisted since undecided descriptors are rolled back
+    Persist(&stat_, sizeof(stat_));
+  }
+  FinalizeTargets(targets_.data(), embedded_num, desc_word, mwcas_success);
+
+  // delayed helpers may refer to this descriptor, but a new generation
+  // prevents them from swapping target words of the next MwCAS
+  stat_.store(((gen + kGenUnit) & kGenMask) | kFree, kRelease);
+  owner_.store(0, kRelease);
+  return mwcas_success;
+}
+
+/*############################################################################*
+ * Internal utility functions
+ *############################################################################*/
+
+auto
+MwCASDescriptor::MapRegion(  //
+    const int fd,
+    const bool is_new,
+    const size_t size,
+    const size_t desc_num,
+    const PersistMode mode)  //
+    -> bool
+{
+  const auto root_offset = kDescOffset + desc_num * sizeof(MwCASDescriptor);
+  if (is_new) {
+    if (desc_num > kIndexMask || size < root_offset + kCacheLineSize
+        || ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      return false;
+    }
+  }
+
+  auto flags = MAP_SHARED;
+#if defined(MAP_SYNC) && defined(MAP_SHARED_VALIDATE)
+  if (mode == kFlush) {
+    flags = MAP_SHARED_VALIDATE | MAP_SYNC;
+  }
+#endif
+  auto* const addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+  if (addr == MAP_FAILED) return false;
+  _base = static_cast<std::byte*>(addr);
+  _size = size;
+  _persist_mode = mode;
+
+  if (is_new) {
+    auto* const descs = _base + kDescOffset;
+    for (size_t i = 0; i < desc_num; ++i) {
+      new (descs + i * sizeof(MwCASDescriptor)) MwCASDescriptor{};
+    }
+    auto* const header = GetHeader(_base);
+    header->size = size;
+    header->desc_num = desc_num;
+    header->root_offset = root_offset;
+    Persist(_base, root_offset);
+
+    // a region is valid only after its magic number is persisted
+    std::atomic_ref{header->magic}.store(kMagic, kRelease);
+    Persist(header, sizeof(RegionHeader));
+  }
+  return true;
+}
+
+auto
+MwCASDescriptor::GetDescriptors()  //
+    -> MwCASDescriptor*
+{
+  return std::launder(reinterpret_cast<MwCASDescriptor*>(_base + kDescOffset));
+}
+
+void
+MwCASDescriptor::FollowIfNeeded(  //
+    std::atomic_uint64_t* const addr,
+    uint64_t& word,
+    const std::memory_order fence)
+{
+  const auto desc_word = word;
+  for (size_t i = 0; i < kRetryNum; ++i) {
+    CPP_UTILITY_SPINLOCK_HINT
+    word = addr->load(fence);
+    if (word != desc_word) return;
+  }
+  std::this_thread::sleep_for(kBackOffTime);
+  word = addr->load(fence);
+  if (word != desc_word) return;  // other threads modified this field
+
+  // a long stall has been detected, so complete the MwCAS instead of its owner
+  HelpStalled(desc_word);
+  word = addr->load(fence);
+}
+
+void
+MwCASDescriptor::HelpStalled(  //
+    const uint64_t desc_word)
+{
+  const auto index = desc_word & kIndexMask;
+  if (index >= GetHeader(_base)->desc_num) return;
+  auto& desc = GetDescriptors()[index];
+  const auto gen = desc_word & kGenMask;
+  auto stat = desc.stat_.load(kAcquire);
+  if ((stat & kGenMask) != gen) return;  // the MwCAS has been completed
+
+  // abort the MwCAS since helpers cannot embed values without versions safely
+  desc.AbortIfUndecided(stat);
+  if ((stat & kGenMask) != gen) return;
+  const auto status = stat & kStatusMask;
+  if (status != kSucceeded && status != kFailed) return;
+
+  // copy the targets and check the descriptor has not been reused
+  std::array<MwCASTarget, kMwCASCapacity> targets{};
+  const auto cnt = std::min(std::atomic_ref{desc.target_cnt_}.load(kRelaxed), kMwCASCapacity);
+  for (size_t i = 0; i < cnt; ++i) {
+    auto& target = desc.targets_[i];
+    targets[i].offset_and_fence = std::atomic_ref{target.offset_and_fence}.load(kRelaxed);
+    targets[i].old_val = std::atomic_ref{target.old_val}.load(kRelaxed);
+    targets[i].new_val = std::atomic_ref{target.new_val}.load(kRelaxed);
+  }
+  std::atomic_thread_fence(kAcquire);
+  if (desc.stat_.load(kRelaxed) != stat) return;
+
+  // the decision must be durable before rolling the MwCAS forward
+  if (status == kSucceeded) {
+    Persist(&desc.stat_, sizeof(desc.stat_));
+  }
+  FinalizeTargets(targets.data(), cnt, desc_word, status == kSucceeded);
+}
+
+void
+MwCASDescriptor::PersistTargets(  //
+    const MwCASTarget* const targets,
+    const size_t cnt)
+{
+  if (_persist_mode == kNoPersist || cnt == 0) return;
+  if (_persist_mode == kMsync) {
+    // write back all the targets by one system call
+    auto min_offset = ~0UL;
+    auto max_offset = 0UL;
+    for (size_t i = 0; i < cnt; ++i) {
+      const auto offset = targets[i].offset_and_fence & ~kFenceMask;
+      min_offset = std::min(min_offset, offset);
+      max_offset = std::max(max_offset, offset);
+    }
+    Persist(_base + min_offset, max_offset - min_offset + sizeof(uint64_t));
+    return;
+  }
+
+  for (size_t i = 0; i < cnt; ++i) {
+    const auto begin = std::bit_cast<uint64_t>(ToAddr(targets[i].offset_and_fence));
+    WriteBackLines(begin, begin + sizeof(uint64_t));
+  }
+  StoreFence();
+}
+
+void
+MwCASDescriptor::FinalizeTargets(  //
+    const MwCASTarget* const targets,
+    const size_t cnt,
+    const uint64_t desc_word,
+    const bool succeeded)
+{
+  for (size_t i = 0; i < cnt; ++i) {
+    const auto& target = targets[i];
+    const auto val = (succeeded) ? target.new_val : target.old_val;
+    auto expected = desc_word;
+    ToAddr(target.offset_and_fence)
+        ->compare_exchange_strong(expected, val | kDirtyFlag, kRelease, kRelaxed);
+  }
+  PersistTargets(targets, cnt);
+  for (size_t i = 0; i < cnt; ++i) {
+    const auto& target = targets[i];
+    auto expected = ((succeeded) ? target.new_val : target.old_val) | kDirtyFlag;
+    ToAddr(target.offset_and_fence)
+        ->compare_exchange_strong(expected, expected & ~kDirtyFlag, kRelaxed, kRelaxed);
+  }
+}
+
+auto
+MwCASDescriptor::CleanDirtyWord(  //
+    std::atomic_uint64_t* const addr,
+    uint64_t word)  //
+    -> uint64_t
+{
+  Persist(addr, sizeof(uint64_t));
+  const auto clean = word & ~kDirtyFlag;
+  addr->compare_exchange_strong(word, clean, kRelaxed, kRelaxed);  // may be cleaned by others
+  return clean;
+}
+
+auto
+MwCASDescriptor::Recover()  //
+    -> size_t
+{
+  const auto desc_num = GetHeader(_base)->desc_num;
+  auto* const descs = GetDescriptors();
+  size_t rec_num = 0;
+  for (size_t i = 0; i < desc_num; ++i) {
+    auto& desc = descs[i];
+    desc.owner_.store(0, kRelaxed);  // all the owners have already exited
+    const auto stat = desc.stat_.load(kRelaxed);
+    if ((stat & kStatusMask) == kFree) continue;
+
+    // roll forward succeeded MwCAS and roll back the others
+    rec_num += static_cast<size_t>(desc.RecoverTargets((stat & kStatusMask) == kSucceeded));
+    desc.stat_.store(((stat + kGenUnit) & kGenMask) | kFree, kRelaxed);
+  }
+  Persist(descs, desc_num * sizeof(MwCASDescriptor));
+
+  return rec_num;
+}
+
+auto
+MwCASDescriptor::RecoverTargets(  //
+    const bool succeeded)  //
+    -> bool
+{
+  const auto root_offset = GetHeader(_base)->root_offset;
+  const auto desc_word = GetDescWord(stat_.load(kRelaxed));
+  const auto cnt = std::min(target_cnt_, kMwCASCapacity);
+  auto recovered = false;
+  for (size_t i = 0; i < cnt; ++i) {
+    const auto& target = targets_[i];
+    const auto offset = target.offset_and_fence & ~kFenceMask;
+    if (offset < root_offset || offset + sizeof(uint64_t) > _size) continue;
+
+    auto* const addr = ToAddr(offset);
+    auto expected = desc_word;
+    const auto desired = (succeeded) ? target.new_val : target.old_val;
+    if (addr->compare_exchange_strong(expected, desired, kRelease, kRelaxed)) {
+      Persist(addr, sizeof(uint64_t));
+      recovered = true;
+    }
+  }
+  return recovered;
+}
+
+auto
+MwCASDescriptor::ReleaseIfAbandoned()  //
+    -> bool
+{
+  auto owner = owner_.load(kAcquire);
+  if (owner == 0 || owner == GetOwnerID() || IsAlive(owner)) return false;
+
+  // take over the descriptor to prevent other processes from releasing it
+  if (!owner_.compare_exchange_strong(owner, GetOwnerID(), kAcquire, kRelaxed)) return false;
+  auto stat = stat_.load(kAcquire);
+  AbortIfUndecided(stat);
+  const auto status = stat & kStatusMask;
+  if (status == kSucceeded || status == kFailed) {
+    if (status == kSucceeded) {
+      Persist(&stat_, sizeof(stat_));
+    }
+    const auto cnt = std::min(target_cnt_, kMwCASCapacity);
+    FinalizeTargets(targets_.data(), cnt, GetDescWord(stat), status == kSucceeded);
+  }
+  stat_.store(((stat + kGenUnit) & kGenMask) | kFree, kRelease);
+  Persist(&stat_, sizeof(stat_));
+  owner_.store(0, kRelease);
+  return true;
+}
+
+auto
+MwCASDescriptor::GetDescWord(  //
+    const uint64_t stat) const  //
+    -> uint64_t
+{
+  const auto index = (ToOffset(this) - kDescOffset) / sizeof(MwCASDescriptor);
+  return kMwCASFlag | (stat & kGenMask) | index;
+}
+
+void
+MwCASDescriptor::AbortIfUndecided(  //
+    uint64_t& stat)
+{
+  if ((stat & kStatusMask) != kUndecided) return;
+  const auto aborted = (stat & kGenMask) | kFailed;
+  if (stat_.compare_exchange_strong(stat, aborted, kAcquire, kAcquire)) {
+    stat = aborted;
+  }
+}
+
+auto
+MwCASDescriptor::EmbedDescriptor(  //
+    const uint64_t desc_word,
+    const size_t pos)  //
+    -> bool
+{
+  const auto& target = targets_[pos];
+  auto* const addr = ToAddr(target.offset_and_fence);
+  const auto fence = static_cast<std::memory_order>(target.offset_and_fence & kFenceMask);
+
+  while (true) {
+    auto expected = addr->load(kRelaxed);
+    while (expected & kMwCASFlag) {
+      FollowIfNeeded(addr, expected, kRelaxed);
+    }
+    if (expected == (target.old_val | kDirtyFlag)) {
+      // the expected value must be durable before it is replaced
+      CleanDirtyWord(addr, expected);
+      continue;
+    }
+    if (expected != target.old_val) return false;
+    if (addr->compare_exchange_strong(expected, desc_word, fence, kRelaxed)) return true;
+  }
+}
+
+}  // namespace dbgroup::atomic::mwcas::persistent
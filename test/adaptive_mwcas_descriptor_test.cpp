@@ -0,0 +1,197 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include <dbgroup/atomic/mwcas/adaptive_mwcas_descriptor.hpp>
+
+// C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kLoopNum = 1e4;
+
+constexpr size_t kFieldNum = kMwCASCapacity * kTestThreadNum;
+
+constexpr auto kSwitchInterval = std::chrono::microseconds{100};
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+class AdaptiveMwCASDescriptorFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using MwCASDesc = AdaptiveMwCASDescriptor;
+  using Target = uint64_t;
+
+  /*##########################################################################*
+   * Setup/Teardown
+   *##########################################################################*/
+
+  static void
+  SetUpTestSuite()
+  {
+    dbgroup::thread::IDManager::SetMaxThreadNum(dbgroup::kMaxThreadCapacity);
+  }
+
+  void
+  SetUp() override
+  {
+    MwCASDesc::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    MwCASDesc::SetMode(MwCASDesc::kDeadlockFree);
+    MwCASDesc::StopGC();
+  }
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  static void
+  VerifyMwCASAfterModeSwitch()
+  {
+    std::array<Target, kMwCASCapacity> fields{};
+
+    auto increment = [&]() {
+      MwCASDesc desc{};
+      for (auto&& field : fields) {
+        const auto cur_val = MwCASDesc::Read<Target>(&field);
+        desc.AddMwCASTarget(&field, cur_val, cur_val + 1);
+      }
+      return desc.MwCAS();
+    };
+
+    [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+
+    // AOPT leaves its completed descriptor in the target words
+    MwCASDesc::SetMode(MwCASDesc::kLockFree);
+    EXPECT_TRUE(increment());
+
+    // the deadlock-free mode must not regard the descriptors as other values
+    MwCASDesc::SetMode(MwCASDesc::kDeadlockFree);
+    EXPECT_TRUE(increment());
+    for (auto&& field : fields) {
+      EXPECT_EQ(MwCASDesc::Read<Target>(&field), 2UL);
+    }
+  }
+
+  static void
+  VerifyMwCASWithModeSwitches(  //
+      const size_t thread_num)
+  {
+    std::array<Target, kFieldNum> fields{};
+
+    auto f = [&](const size_t rand_seed) {
+      std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+      std::uniform_int_distribution<size_t> dist{0, kFieldNum - 1};
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        // select MwCAS target fields randomly
+        std::vector<size_t> targets{};
+        while (targets.size() < kMwCASCapacity) {
+          const auto idx = dist(rand_engine);
+          if (std::find(targets.begin(), targets.end(), idx) == targets.end()) {
+            targets.emplace_back(idx);
+          }
+        }
+        std::sort(targets.begin(), targets.end());
+
+        while (true) {
+          [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+          MwCASDesc desc{};
+          for (const auto idx : targets) {
+            const auto cur_val = MwCASDesc::Read<Target>(&(fields[idx]), kRelaxed);
+            desc.AddMwCASTarget(&(fields[idx]), cur_val, cur_val + 1, kRelaxed);
+          }
+          if (desc.MwCAS()) break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, rand_engine());
+    }
+
+    // switch modes repeatedly while the workers perform MwCAS
+    std::atomic_bool running{true};
+    std::thread switcher{[&] {
+      auto mode = MwCASDesc::kLockFree;
+      while (running.load(kRelaxed)) {
+        MwCASDesc::SetMode(mode);
+        mode = (mode == MwCASDesc::kLockFree) ? MwCASDesc::kDeadlockFree : MwCASDesc::kLockFree;
+        std::this_thread::sleep_for(kSwitchInterval);
+      }
+    }};
+    for (auto&& t : threads) t.join();
+    running.store(false, kRelaxed);
+    switcher.join();
+
+    // check the target fields are correctly incremented
+    size_t sum = 0;
+    for (auto&& field : fields) {
+      sum += MwCASDesc::Read<Target>(&field);
+    }
+    EXPECT_EQ(kLoopNum * thread_num * kMwCASCapacity, sum);
+  }
+};
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(  //
+    AdaptiveMwCASDescriptorFixture,
+    MwCASAfterSwitchingToDeadlockFreeModeSucceeds)
+{
+  VerifyMwCASAfterModeSwitch();
+}
+
+TEST_F(  //
+    AdaptiveMwCASDescriptorFixture,
+    MwCASWithModeSwitchesCorrectlyIncrementTargets)
+{
+  VerifyMwCASWithModeSwitches(kTestThreadNum);
+}
+
+}  // namespace dbgroup::atomic::mwcas::test
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding headers
+#include <dbgroup/atomic/mwcas/atomic.hpp>
+#include <dbgroup/atomic/mwcas/deadlock_free/mwcas_descriptor.hpp>
+#include <dbgroup/atomic/mwcas/lock_free/aopt_descriptor.hpp>
+#include <dbgroup/atomic/mwcas/lock_free/mwcas128_descriptor.hpp>
+#include <dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp>
+
+// C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Target MwCAS implementations
+ *############################################################################*/
+
+using DLFMwCAS = deadlock_free::MwCASDescriptor;
+using LFMwCAS = lock_free::MwCASDescriptor;
+using AOPT = lock_free::AOPTDescriptor;
+using MwCAS128 = lock_free::MwCAS128Descriptor;
+
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kLoopNum = 1e5;
+
+constexpr size_t kFieldNum = kMwCASCapacity * kTestThreadNum;
+
+constexpr uint64_t kInitVal = 42;
+
+/*############################################################################*
+ * Static checks
+ *############################################################################*/
+
+static_assert(sizeof(Atomic<uint64_t, DLFMwCAS>) == sizeof(uint64_t));
+static_assert(sizeof(Atomic<uint64_t, LFMwCAS>) == sizeof(uint64_t));
+static_assert(sizeof(Atomic<uint64_t, MwCAS128>) == sizeof(MwCAS128::Word));
+static_assert(sizeof(Atomic<uint64_t, DLFMwCAS, CacheLinePadding>) == kCacheLineSize);
+static_assert(std::is_same_v<Atomic<uint64_t, DLFMwCAS>::Expected, uint64_t>);
+static_assert(std::is_same_v<Atomic<uint64_t, MwCAS128>::Expected, MwCAS128::Word>);
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+template <class MwCASDesc>
+class AtomicFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using Field = Atomic<uint64_t, MwCASDesc>;
+  using PaddedField = Atomic<uint64_t, MwCASDesc, CacheLinePadding>;
+
+  /*##########################################################################*
+   * Internal constants
+   *##########################################################################*/
+
+  static constexpr bool kUseGC = !std::is_same_v<MwCASDesc, DLFMwCAS>;
+
+  /*##########################################################################*
+   * Setup/Teardown
+   *##########################################################################*/
+
+  static void
+  SetUpTestSuite()
+  {
+    dbgroup::thread::IDManager::SetMaxThreadNum(dbgroup::kMaxThreadCapacity);
+  }
+
+  void
+  SetUp() override
+  {
+    if constexpr (kUseGC) {
+      MwCASDesc::StartGC();
+    }
+  }
+
+  void
+  TearDown() override
+  {
+    if constexpr (kUseGC) {
+      MwCASDesc::StopGC();
+    }
+  }
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  void
+  VerifyLoad()
+  {
+    Field field{kInitVal};
+    EXPECT_EQ(field.Load(), kInitVal);
+
+    const auto [val, expected] = field.LoadForMwCAS();
+    EXPECT_EQ(val, kInitVal);
+    if constexpr (std::is_same_v<MwCASDesc, MwCAS128>) {
+      EXPECT_EQ(expected.val, kInitVal);
+    } else {
+      EXPECT_EQ(expected, kInitVal);
+    }
+  }
+
+  template <class F>
+  void
+  VerifyMwCAS(  //
+      const size_t thread_num)
+  {
+    std::array<F, kFieldNum> fields{};
+
+    auto f = [&](const size_t rand_seed) {
+      std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+      std::uniform_int_distribution<size_t> dist{0, kFieldNum - 1};
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        // select MwCAS target fields randomly
+        std::vector<size_t> targets{};
+        while (targets.size() < kMwCASCapacity) {
+          const auto idx = dist(rand_engine);
+          if (std::find(targets.begin(), targets.end(), idx) == targets.end()) {
+            targets.emplace_back(idx);
+          }
+        }
+        std::sort(targets.begin(), targets.end());
+        MwCAS(fields, targets);
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, rand_engine());
+    }
+    for (auto&& t : threads) t.join();
+
+    // check the target fields are correctly incremented
+    size_t sum = 0;
+    for (auto&& field : fields) {
+      sum += field.Load();
+    }
+    EXPECT_EQ(kLoopNum * thread_num * kMwCASCapacity, sum);
+  }
+
+ private:
+  /*##########################################################################*
+   * Internal utility functions
+   *##########################################################################*/
+
+  template <class F>
+  static void
+  MwCAS(  //
+      std::array<F, kFieldNum>& fields,
+      const std::vector<size_t>& targets)
+  {
+    while (true) {
+      if constexpr (kUseGC) {
+        [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+        auto* const desc = MwCASDesc::GetDescriptor();
+        for (auto idx : targets) {
+          const auto [cur_val, expected] = fields[idx].LoadForMwCAS(kRelaxed);
+          fields[idx].AddMwCASTarget(*desc, expected, cur_val + 1, kRelaxed);
+        }
+        if (desc->MwCAS()) return;
+      } else {
+        MwCASDesc desc{};
+        for (auto idx : targets) {
+          const auto [cur_val, expected] = fields[idx].LoadForMwCAS(kRelaxed);
+          fields[idx].AddMwCASTarget(desc, expected, cur_val + 1, kRelaxed);
+        }
+        if (desc.MwCAS()) return;
+      }
+    }
+  }
+};
+
+/*############################################################################*
+ * Preparation for typed testing
+ *############################################################################*/
+
+using MwCASDescriptors = ::testing::Types<DLFMwCAS, LFMwCAS, AOPT, MwCAS128>;
+TYPED_TEST_SUITE(AtomicFixture, MwCASDescriptors);
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TYPED_TEST(  //
+    AtomicFixture,
+    LoadReturnsInitialValue)
+{
+  TestFixture::VerifyLoad();
+}
+
+TYPED_TEST(  //
+    AtomicFixture,
+    MwCASWithMultiThreadsCorrectlyIncrementFields)
+{
+  TestFixture::template VerifyMwCAS<typename TestFixture::Field>(kTestThreadNum);
+}
+
+TYPED_TEST(  //
+    AtomicFixture,
+    MwCASWithMultiThreadsCorrectlyIncrementPaddedFields)
+{
+  TestFixture::template VerifyMwCAS<typename TestFixture::PaddedField>(kTestThreadNum);
+}
+
+}  // namespace dbgroup::atomic::mwcas::test
@@ -0,0 +1,585 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding headers
+#include <dbgroup/atomic/mwcas/deadlock_free/awaitable.hpp>
+#include <dbgroup/atomic/mwcas/lock_free/awaitable.hpp>
+
+// C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kLoopNum = 1e4;
+
+constexpr size_t kTaskNum = 8;
+
+constexpr size_t kFieldNum = kMwCASCapacity * kTestThreadNum;
+
+constexpr uint64_t kInitVal = 42;
+
+constexpr size_t kBlockedNum = 10;
+
+/*############################################################################*
+ * A minimal executor for testing
+ *############################################################################*/
+
+template <class T>
+class Task;
+
+/**
+ * @brief The base of promises for returning values.
+ *
+ */
+template <class T>
+struct ReturnValue {
+  void
+  return_value(  // NOLINT
+      T val)
+  {
+    result = std::move(val);
+  }
+
+  std::optional<T> result{};
+};
+
+/**
+ * @brief The base of promises for returning nothing.
+ *
+ */
+template <>
+struct ReturnValue<void> {
+  void
+  return_void()  // NOLINT
+  {
+  }
+};
+
+/**
+ * @brief A lazy task that resumes its awaiter when it completes.
+ *
+ */
+template <class T>
+class Task
+{
+ public:
+  struct promise_type : public ReturnValue<T> {  // NOLINT
+    struct FinalAwaiter {
+      [[nodiscard]] auto
+      await_ready() const noexcept  // NOLINT
+          -> bool
+      {
+        return false;
+      }
+
+      auto
+      await_suspend(  // NOLINT
+          std::coroutine_handle<promise_type> h) noexcept  //
+          -> std::coroutine_handle<>
+      {
+        const auto next = h.promise().next;
+        return next ? next : std::noop_coroutine();
+      }
+
+      void
+      await_resume() noexcept  // NOLINT
+      {
+      }
+    };
+
+    auto
+    get_return_object()  // NOLINT
+        -> Task
+    {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    auto
+    initial_suspend() noexcept  // NOLINT
+        -> std::suspend_always
+    {
+      return {};
+    }
+
+    auto
+    final_suspend() noexcept  // NOLINT
+        -> FinalAwaiter
+    {
+      return {};
+    }
+
+    void
+    unhandled_exception()  // NOLINT
+    {
+      std::terminate();
+    }
+
+    std::coroutine_handle<> next{};
+  };
+
+  explicit Task(  //
+      std::coroutine_handle<promise_type> h)
+      : handle_{h}
+  {
+  }
+
+  Task(const Task&) = delete;
+  Task(  //
+      Task&& obj) noexcept
+      : handle_{std::exchange(obj.handle_, nullptr)}
+  {
+  }
+
+  auto operator=(const Task& obj) -> Task& = delete;
+  auto operator=(Task&&) -> Task& = delete;
+
+  ~Task()
+  {
+    if (handle_) handle_.destroy();
+  }
+
+  [[nodiscard]] auto
+  await_ready() const noexcept  // NOLINT
+      -> bool
+  {
+    return false;
+  }
+
+  auto
+  await_suspend(  // NOLINT
+      std::coroutine_handle<> awaiter) noexcept  //
+      -> std::coroutine_handle<>
+  {
+    handle_.promise().next = awaiter;
+    return handle_;
+  }
+
+  auto
+  await_resume()  // NOLINT
+      -> T
+  {
+    if constexpr (!std::is_void_v<T>) {
+      return std::move(*(handle_.promise().result));
+    }
+  }
+
+  [[nodiscard]] auto
+  Handle() const  //
+      -> std::coroutine_handle<>
+  {
+    return handle_;
+  }
+
+  [[nodiscard]] auto
+  Done() const  //
+      -> bool
+  {
+    return handle_.done();
+  }
+
+ private:
+  std::coroutine_handle<promise_type> handle_{};
+};
+
+/**
+ * @brief A single-thread executor that runs tasks in a round-robin manner.
+ *
+ */
+class Executor
+{
+ public:
+  /**
+   * @brief An awaitable for yielding the current thread to other tasks.
+   *
+   */
+  struct Yield {
+    [[nodiscard]] auto
+    await_ready() const noexcept  // NOLINT
+        -> bool
+    {
+      return false;
+    }
+
+    void
+    await_suspend(  // NOLINT
+        std::coroutine_handle<> h)
+    {
+      ++(exec->yield_cnt);
+      exec->queue.emplace_back(h);
+    }
+
+    void
+    await_resume() noexcept  // NOLINT
+    {
+    }
+
+    Executor* exec{};
+  };
+
+  [[nodiscard]] auto
+  BackOff()  //
+  {
+    return [this] { return Yield{this}; };
+  }
+
+  template <class T>
+  void
+  Run(  //
+      std::vector<Task<T>>& tasks)
+  {
+    for (auto&& task : tasks) {
+      queue.emplace_back(task.Handle());
+    }
+    while (!queue.empty()) {
+      const auto h = queue.front();
+      queue.pop_front();
+      h.resume();
+    }
+  }
+
+  std::deque<std::coroutine_handle<>> queue{};
+
+  size_t yield_cnt{0};
+};
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+class AwaitableFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using MwCASDesc = deadlock_free::MwCASDescriptor;
+  using LockFreeDesc = lock_free::MwCASDescriptor;
+
+  /*##########################################################################*
+   * Setup/Teardown
+   *##########################################################################*/
+
+  static void
+  SetUpTestSuite()
+  {
+    dbgroup::thread::IDManager::SetMaxThreadNum(dbgroup::kMaxThreadCapacity);
+  }
+
+  void
+  SetUp() override
+  {
+    LockFreeDesc::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    LockFreeDesc::StopGC();
+  }
+
+  /*##########################################################################*
+   * Utility functions
+   *##########################################################################*/
+
+  static auto
+  ReleaseLater(  //
+      uint64_t* word,
+      const size_t blocked_num,
+      Executor::Yield yield)  //
+      -> Task<bool>
+  {
+    for (size_t i = 0; i < blocked_num; ++i) {
+      co_await yield;
+    }
+    std::atomic_ref{*word}.store(kInitVal);
+    co_return true;
+  }
+
+  static auto
+  IncrementRandomly(  //
+      std::array<uint64_t, kFieldNum>& fields,
+      const size_t rand_seed,
+      Executor& exec)  //
+      -> Task<bool>
+  {
+    std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+    std::uniform_int_distribution<size_t> dist{0, kFieldNum - 1};
+    for (size_t i = 0; i < kLoopNum; ++i) {
+      // select MwCAS target fields randomly
+      std::vector<size_t> targets{};
+      while (targets.size() < kMwCASCapacity) {
+        const auto idx = dist(rand_engine);
+        if (std::find(targets.begin(), targets.end(), idx) == targets.end()) {
+          targets.emplace_back(idx);
+        }
+      }
+
+      auto prepare = [&](MwCASDesc& desc) {
+        for (const auto idx : targets) {
+          const auto val = MwCASDesc::TryRead<uint64_t>(&(fields[idx]), kRelaxed);
+          if (!val) return Preparation::kRetry;
+          desc.AddMwCASTarget(&(fields[idx]), *val, *val + 1, kRelaxed);
+        }
+        return Preparation::kReady;
+      };
+      const auto succeeded = co_await deadlock_free::MwCASAsync<Task>(prepare, exec.BackOff());
+      EXPECT_TRUE(succeeded);
+    }
+    co_return true;
+  }
+
+  static auto
+  IncrementRandomlyWithHelping(  //
+      std::array<uint64_t, kFieldNum>& fields,
+      const size_t rand_seed,
+      Executor& exec)  //
+      -> Task<bool>
+  {
+    std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+    std::uniform_int_distribution<size_t> dist{0, kFieldNum - 1};
+    for (size_t i = 0; i < kLoopNum; ++i) {
+      // select MwCAS target fields randomly
+      std::vector<size_t> targets{};
+      while (targets.size() < kMwCASCapacity) {
+        const auto idx = dist(rand_engine);
+        if (std::find(targets.begin(), targets.end(), idx) == targets.end()) {
+          targets.emplace_back(idx);
+        }
+      }
+
+      // keep blocked words across back-off for helping stalled descriptors
+      std::array<uint64_t, kMwCASCapacity> stalled{};
+      auto prepare = [&](LockFreeDesc* desc) {
+        for (size_t j = 0; j < kMwCASCapacity; ++j) {
+          auto* const addr = &(fields[targets[j]]);
+          const auto val = LockFreeDesc::TryRead<uint64_t>(addr, stalled[j], kRelaxed);
+          if (!val) return Preparation::kRetry;
+          desc->AddMwCASTarget(addr, val->second, val->first + 1, kRelaxed);
+        }
+        return Preparation::kReady;
+      };
+      const auto succeeded = co_await lock_free::MwCASAsync<Task>(prepare, exec.BackOff());
+      EXPECT_TRUE(succeeded);
+    }
+    co_return true;
+  }
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  static void
+  VerifyReadAsync()
+  {
+    // a word blocked by a (dummy) descriptor
+    uint64_t word = kMwCASFlag | kDeadlockFreeFlag;
+
+    Executor exec{};
+    std::vector<Task<uint64_t>> readers{};
+    readers.emplace_back(deadlock_free::ReadAsync<Task, uint64_t>(&word, exec.BackOff()));
+    std::vector<Task<bool>> releasers{};
+    releasers.emplace_back(ReleaseLater(&word, kBlockedNum, Executor::Yield{&exec}));
+    exec.queue.emplace_back(readers.front().Handle());
+    exec.Run(releasers);
+
+    // the reader has yielded to the releaser instead of sleeping
+    ASSERT_TRUE(readers.front().Done());
+    EXPECT_EQ(readers.front().await_resume(), kInitVal);
+    EXPECT_GT(exec.yield_cnt, kBlockedNum);
+  }
+
+  static void
+  VerifyMwCASAsync(  //
+      const size_t thread_num)
+  {
+    std::array<uint64_t, kFieldNum> fields{};
+
+    auto f = [&](const size_t rand_seed) {
+      std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+      Executor exec{};
+      std::vector<Task<bool>> tasks{};
+      for (size_t i = 0; i < kTaskNum; ++i) {
+        tasks.emplace_back(IncrementRandomly(fields, rand_engine(), exec));
+      }
+      exec.Run(tasks);
+      for (auto&& task : tasks) {
+        EXPECT_TRUE(task.Done());
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, rand_engine());
+    }
+    for (auto&& t : threads) t.join();
+
+    // check the target fields are correctly incremented
+    size_t sum = 0;
+    for (auto&& field : fields) {
+      sum += MwCASDesc::Read<uint64_t>(&field);
+    }
+    EXPECT_EQ(kLoopNum * kTaskNum * thread_num * kMwCASCapacity, sum);
+  }
+
+  static void
+  VerifyLockFreeMwCASAsync(  //
+      const size_t thread_num)
+  {
+    std::array<uint64_t, kFieldNum> fields{};
+
+    auto f = [&](const size_t rand_seed) {
+      std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+      Executor exec{};
+      std::vector<Task<bool>> tasks{};
+      for (size_t i = 0; i < kTaskNum; ++i) {
+        tasks.emplace_back(IncrementRandomlyWithHelping(fields, rand_engine(), exec));
+      }
+      exec.Run(tasks);
+      for (auto&& task : tasks) {
+        EXPECT_TRUE(task.Done());
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, rand_engine());
+    }
+    for (auto&& t : threads) t.join();
+
+    // check the target fields are correctly incremented
+    size_t sum = 0;
+    for (auto&& field : fields) {
+      sum += LockFreeDesc::Read<uint64_t>(&field).first;
+    }
+    EXPECT_EQ(kLoopNum * kTaskNum * thread_num * kMwCASCapacity, sum);
+  }
+
+  static void
+  VerifyLockFreeReadAsync()
+  {
+    // a word blocked by a (dummy) descriptor, which is released before helping
+    uint64_t word = kMwCASFlag;
+
+    Executor exec{};
+    std::vector<Task<std::pair<uint64_t, uint64_t>>> readers{};
+    readers.emplace_back(lock_free::ReadAsync<Task, uint64_t>(&word, exec.BackOff()));
+    std::vector<Task<bool>> releasers{};
+    releasers.emplace_back(ReleaseLater(&word, 0, Executor::Yield{&exec}));
+    exec.queue.emplace_back(readers.front().Handle());
+    exec.Run(releasers);
+
+    // the reader has yielded to the releaser instead of sleeping
+    ASSERT_TRUE(readers.front().Done());
+    EXPECT_EQ(readers.front().await_resume().first, kInitVal);
+    EXPECT_GT(exec.yield_cnt, 0UL);
+  }
+
+  static void
+  VerifyMwCASAsyncAbort()
+  {
+    uint64_t word = kInitVal;
+
+    // aborted operations return false without any back-off or modification
+    Executor exec{};
+    std::vector<Task<bool>> tasks{};
+    tasks.emplace_back(deadlock_free::MwCASAsync<Task>(
+        [&](MwCASDesc& desc) {
+          desc.AddMwCASTarget(&word, kInitVal, kInitVal + 1);
+          return Preparation::kAbort;
+        },
+        exec.BackOff()));
+    tasks.emplace_back(lock_free::MwCASAsync<Task>(
+        [&](LockFreeDesc* desc) {
+          desc->AddMwCASTarget(&word, kInitVal, kInitVal + 1);
+          return Preparation::kAbort;
+        },
+        exec.BackOff()));
+    exec.Run(tasks);
+    for (auto&& task : tasks) {
+      ASSERT_TRUE(task.Done());
+      EXPECT_FALSE(task.await_resume());
+    }
+    EXPECT_EQ(exec.yield_cnt, 0UL);
+    EXPECT_EQ(MwCASDesc::Read<uint64_t>(&word), kInitVal);
+  }
+};
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(  //
+    AwaitableFixture,
+    ReadAsyncYieldsToOtherTasksWhileWordIsBlocked)
+{
+  VerifyReadAsync();
+}
+
+TEST_F(  //
+    AwaitableFixture,
+    MwCASAsyncWithMultiThreadsCorrectlyIncrementTargets)
+{
+  VerifyMwCASAsync(kTestThreadNum);
+}
+
+TEST_F(  //
+    AwaitableFixture,
+    MwCASAsyncReturnsFalseIfPreparationIsAborted)
+{
+  VerifyMwCASAsyncAbort();
+}
+
+TEST_F(  //
+    AwaitableFixture,
+    LockFreeReadAsyncYieldsToOtherTasksWhileWordIsBlocked)
+{
+  VerifyLockFreeReadAsync();
+}
+
+TEST_F(  //
+    AwaitableFixture,
+    LockFreeMwCASAsyncWithMultiThreadsCorrectlyIncrementTargets)
+{
+  VerifyLockFreeMwCASAsync(kTestThreadNum);
+}
+
+}  // namespace dbgroup::atomic::mwcas::test
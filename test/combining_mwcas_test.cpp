@@ -0,0 +1,233 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include <dbgroup/atomic/mwcas/lock_free/combining_mwcas.hpp>
+
+// C++ standard libraries
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kLoopNum = 1e5;
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+class CombiningMwCASFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using MwCASDesc = lock_free::MwCASDescriptor;
+  using CombiningMwCAS = lock_free::CombiningMwCAS;
+  using Operation = CombiningMwCAS::Operation;
+  using Request = CombiningMwCAS::Request;
+
+  /*##########################################################################*
+   * Setup/Teardown
+   *##########################################################################*/
+
+  static void
+  SetUpTestSuite()
+  {
+    dbgroup::thread::IDManager::SetMaxThreadNum(dbgroup::kMaxThreadCapacity);
+  }
+
+  void
+  SetUp() override
+  {
+    fields_.fill(0);
+    MwCASDesc::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    MwCASDesc::StopGC();
+  }
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  void
+  VerifyExecute(  //
+      const size_t thread_num,
+      const size_t abort_interval)
+  {
+    // all the threads increment the same fields to cause heavy conflicts
+    auto f = [&]() {
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        const auto abort = (abort_interval > 0 && i % abort_interval == 0);
+        const auto succeeded = CombiningMwCAS::Execute(fields_.data(), [&](MwCASDesc* desc) {
+          if (abort) return false;
+          for (auto&& field : fields_) {
+            const auto [cur_val, word] = MwCASDesc::Read<uint64_t>(&field, kRelaxed);
+            desc->AddMwCASTarget(&field, word, cur_val + 1, kRelaxed);
+          }
+          return true;
+        });
+        EXPECT_NE(succeeded, abort);
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f);
+    }
+    for (auto&& t : threads) t.join();
+
+    // check the fields are incremented exactly once by each operation
+    const auto aborted_num = (abort_interval > 0) ? (kLoopNum - 1) / abort_interval + 1 : 0;
+    for (auto&& field : fields_) {
+      EXPECT_EQ(MwCASDesc::Read<uint64_t>(&field).first, (kLoopNum - aborted_num) * thread_num);
+    }
+  }
+
+  void
+  VerifyCombineInFIFOOrder()
+  {
+    auto* const key = fields_.data();
+    auto& shard = CombiningMwCAS::GetShard(key);
+    std::vector<size_t> applied{};
+
+    // prepare operations that succeed, abort, and keep failing
+    auto increment = [&](const size_t id) {
+      return [&, id](MwCASDesc* desc) {
+        applied.emplace_back(id);
+        const auto [cur_val, word] = MwCASDesc::Read<uint64_t>(key);
+        desc->AddMwCASTarget(key, word, cur_val + 1);
+        return true;
+      };
+    };
+    auto abort = [&](MwCASDesc*) {
+      applied.emplace_back(1);
+      return false;
+    };
+    auto fail = [&](MwCASDesc* desc) {
+      applied.emplace_back(2);
+      const auto [cur_val, word] = MwCASDesc::Read<uint64_t>(key);
+      desc->AddMwCASTarget(key, word + 1, cur_val + 1);
+      return true;
+    };
+    const auto first = increment(0);
+    const auto last = increment(3);
+
+    // publish requests in advance as if other threads have been waiting
+    Request req0{Operation{&CombiningMwCAS::Invoke<decltype(first)>, &first}};
+    Request req1{Operation{&CombiningMwCAS::Invoke<decltype(abort)>, &abort}};
+    Request req2{Operation{&CombiningMwCAS::Invoke<decltype(fail)>, &fail}};
+    Request req3{Operation{&CombiningMwCAS::Invoke<decltype(last)>, &last}};
+    req1.next = &req0;
+    req2.next = &req1;
+    shard.contention.store(CombiningMwCAS::kHotThreshold, kRelaxed);
+    shard.head.store(&req2, kRelaxed);
+
+    // this thread becomes a combiner and applies the requests in FIFO order
+    [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+    EXPECT_EQ(CombiningMwCAS::Combine(shard, req3), CombiningMwCAS::kSucceeded);
+    EXPECT_TRUE(req0.done.load() && req1.done.load() && req2.done.load());
+    EXPECT_EQ(req0.status, CombiningMwCAS::kSucceeded);
+    EXPECT_EQ(req1.status, CombiningMwCAS::kAborted);
+    EXPECT_EQ(req2.status, CombiningMwCAS::kRetry);
+
+    std::vector<size_t> expected{0, 1};
+    expected.insert(expected.end(), kRetryNum, 2);
+    expected.emplace_back(3);
+    EXPECT_EQ(applied, expected);
+    EXPECT_EQ(MwCASDesc::Read<uint64_t>(key).first, 2UL);
+    EXPECT_EQ(shard.head.load(), nullptr);
+    EXPECT_FALSE(shard.combining.load());
+  }
+
+  void
+  VerifyExecuteOnHotShard()
+  {
+    auto* const key = fields_.data();
+    auto& shard = CombiningMwCAS::GetShard(key);
+
+    // a hot shard makes an operation be published and combined
+    shard.contention.store(CombiningMwCAS::kHotThreshold, kRelaxed);
+    const auto succeeded = CombiningMwCAS::Execute(key, [&](MwCASDesc* desc) {
+      const auto [cur_val, word] = MwCASDesc::Read<uint64_t>(key);
+      desc->AddMwCASTarget(key, word, cur_val + 1);
+      return true;
+    });
+    EXPECT_TRUE(succeeded);
+    EXPECT_EQ(MwCASDesc::Read<uint64_t>(key).first, 1UL);
+
+    // a combiner without other requests returns the shard to usual MwCAS
+    EXPECT_EQ(shard.contention.load(), 0UL);
+  }
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  std::array<uint64_t, kMwCASCapacity> fields_{};
+};
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(  //
+    CombiningMwCASFixture,
+    ExecuteWithMultiThreadsCorrectlyIncrementTargets)
+{
+  VerifyExecute(kTestThreadNum, 0);
+}
+
+TEST_F(  //
+    CombiningMwCASFixture,
+    ExecuteWithAbortedOperationsNeverIncrementTargets)
+{
+  VerifyExecute(kTestThreadNum, 10);
+}
+
+TEST_F(  //
+    CombiningMwCASFixture,
+    CombinerAppliesPublishedRequestsInFIFOOrder)
+{
+  VerifyCombineInFIFOOrder();
+}
+
+TEST_F(  //
+    CombiningMwCASFixture,
+    ExecuteOnHotShardIsCombined)
+{
+  VerifyExecuteOnHotShard();
+}
+
+}  // namespace dbgroup::atomic::mwcas::test
@@ -0,0 +1,313 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include <dbgroup/atomic/mwcas/deadlock_free/mwcas_descriptor.hpp>
+
+// C++ standard libraries
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kTargetFieldNum = kMwCASCapacity * kTestThreadNum;
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+class DeadlockFreeMwCASDescriptorFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using MwCASDesc = deadlock_free::MwCASDescriptor;
+  using Target = uint64_t;
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  void
+  VerifyMaskedMwCAS(  //
+      const size_t thread_num)
+  {
+    constexpr size_t kLaneBitNum = 14;
+    constexpr size_t kLoopNum = 1e4;
+    constexpr uint64_t kLaneMask = (1UL << kLaneBitNum) - 1UL;
+
+    // each thread increments its own lane in shared words
+    auto f = [&](const size_t lane) {
+      const auto shift = lane * kLaneBitNum;
+      const auto mask = kLaneMask << shift;
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        while (true) {
+          MwCASDesc desc{};
+          for (size_t j = 0; j < kMwCASCapacity; ++j) {
+            auto* const addr = &(target_fields_[j]);
+            const auto cur_val = MwCASDesc::Read<Target>(addr, kRelaxed);
+            const auto new_val = ((cur_val & mask) + (1UL << shift)) & mask;
+            desc.AddMaskedTarget(addr, mask, cur_val, new_val, kRelaxed);
+          }
+          if (desc.MwCAS()) break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, i);
+    }
+    for (auto&& t : threads) t.join();
+
+    // check each lane is incremented without lost updates
+    for (size_t j = 0; j < kMwCASCapacity; ++j) {
+      const auto val = MwCASDesc::Read<Target>(&(target_fields_[j]));
+      for (size_t i = 0; i < thread_num; ++i) {
+        EXPECT_EQ((val >> (i * kLaneBitNum)) & kLaneMask, kLoopNum);
+      }
+    }
+  }
+
+  void
+  VerifyDeltaMwCAS(  //
+      const size_t thread_num)
+  {
+    constexpr size_t kLoopNum = 1e5;
+    auto* const counter = &(target_fields_[kTargetFieldNum - 1]);
+
+    // each thread swaps its own field and increments a shared counter
+    auto f = [&](const size_t idx) {
+      auto* const addr = &(target_fields_[idx]);
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        while (true) {
+          // MwCAS may fail only if it cannot wait for embedded descriptors
+          MwCASDesc desc{};
+          const auto cur_val = MwCASDesc::Read<Target>(addr, kRelaxed);
+          desc.AddMwCASTarget(addr, cur_val, cur_val + 1, kRelaxed);
+          desc.AddDeltaTarget(counter, 1L, kRelaxed);
+          if (desc.MwCAS()) break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, i);
+    }
+    for (auto&& t : threads) t.join();
+
+    for (size_t i = 0; i < thread_num; ++i) {
+      EXPECT_EQ(MwCASDesc::Read<Target>(&(target_fields_[i])), kLoopNum);
+    }
+    EXPECT_EQ(MwCASDesc::Read<Target>(counter), kLoopNum * thread_num);
+  }
+
+  void
+  VerifyOverflowedDeltaMwCAS()
+  {
+    auto* const addr = &(target_fields_[0]);
+    auto* const counter = &(target_fields_[1]);
+
+    // a negative counter and a carry into the MwCAS flag make MwCAS fail
+    for (const auto& [init_cnt, delta] : {std::pair{0UL, -1L}, std::pair{kMwCASFlag - 1, 1L}}) {
+      std::atomic_ref{*counter}.store(init_cnt);
+      MwCASDesc desc{};
+      desc.AddMwCASTarget(addr, 0UL, 1UL);
+      desc.AddDeltaTarget(counter, delta);
+      EXPECT_FALSE(desc.MwCAS());
+
+      // the other target must be rolled back
+      EXPECT_EQ(MwCASDesc::Read<Target>(addr), 0UL);
+      EXPECT_EQ(std::atomic_ref{*counter}.load(), init_cnt);
+    }
+  }
+
+  void
+  VerifyMwCASWithUnsortedTargets(  //
+      const size_t thread_num)
+  {
+    constexpr size_t kLoopNum = 1e5;
+
+    // each thread registers random targets without sorting them
+    auto f = [&](const size_t rand_seed) {
+      std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+      std::uniform_int_distribution<size_t> dist{0, kTargetFieldNum - 1};
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        std::vector<size_t> targets{};
+        while (targets.size() < kMwCASCapacity) {
+          const auto idx = dist(rand_engine);
+          if (std::find(targets.begin(), targets.end(), idx) == targets.end()) {
+            targets.emplace_back(idx);
+          }
+        }
+        while (true) {
+          MwCASDesc desc{};
+          for (const auto idx : targets) {
+            auto* const addr = &(target_fields_[idx]);
+            const auto cur_val = MwCASDesc::Read<Target>(addr, kRelaxed);
+            desc.AddMwCASTarget(addr, cur_val, cur_val + 1, kRelaxed);
+          }
+          if (desc.MwCAS()) break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, rand_engine());
+    }
+    for (auto&& t : threads) t.join();
+
+    size_t sum = 0;
+    for (auto& field : target_fields_) {
+      sum += MwCASDesc::Read<Target>(&field);
+    }
+    EXPECT_EQ(kLoopNum * thread_num * kMwCASCapacity, sum);
+  }
+
+  void
+  VerifyDuplicatedTargets()
+  {
+    auto* const addr = &(target_fields_[0]);
+    auto* const counter = &(target_fields_[1]);
+
+    // targets with the same address are merged
+    MwCASDesc desc{};
+    desc.AddDeltaTarget(counter, 1L);
+    desc.AddMaskedTarget(addr, 0xFFUL, 0UL, 1UL);
+    desc.AddDeltaTarget(counter, 2L);
+    desc.AddMaskedTarget(addr, 0xFF00UL, 0UL, 0x200UL);
+    EXPECT_EQ(desc.Size(), 2UL);
+    EXPECT_TRUE(desc.MwCAS());
+    EXPECT_EQ(MwCASDesc::Read<Target>(addr), 0x201UL);
+    EXPECT_EQ(MwCASDesc::Read<Target>(counter), 3UL);
+
+    // conflicting targets make MwCAS fail without any modification
+    MwCASDesc conflicted{};
+    conflicted.AddDeltaTarget(counter, 1L);
+    conflicted.AddMwCASTarget(addr, 0x201UL, 0x202UL);
+    conflicted.AddMwCASTarget(addr, 0x201UL, 0x203UL);
+    EXPECT_FALSE(conflicted.MwCAS());
+    EXPECT_EQ(MwCASDesc::Read<Target>(addr), 0x201UL);
+    EXPECT_EQ(MwCASDesc::Read<Target>(counter), 3UL);
+
+    // a delta cannot be merged with a new value
+    MwCASDesc mixed{};
+    mixed.AddMaskedTarget(addr, 0xFFUL, 1UL, 2UL);
+    mixed.AddDeltaTarget(addr, 1L);
+    EXPECT_FALSE(mixed.MwCAS());
+    EXPECT_EQ(MwCASDesc::Read<Target>(addr), 0x201UL);
+  }
+
+  void
+  VerifyRetriedMwCAS()
+  {
+    auto* const counter = &(target_fields_[0]);
+    auto* const addr = &(target_fields_[1]);
+
+    // the first MwCAS fails due to the masked target and rolls back the counter
+    MwCASDesc desc{};
+    desc.AddDeltaTarget(counter, 1L);
+    desc.AddMaskedTarget(addr, 0xFFUL, 1UL, 2UL);
+    EXPECT_FALSE(desc.MwCAS());
+    EXPECT_EQ(MwCASDesc::Read<Target>(counter), 0UL);
+
+    // a retry applies the registered operands only once
+    std::atomic_ref{*addr}.store(0x101UL);
+    EXPECT_TRUE(desc.MwCAS());
+    EXPECT_EQ(MwCASDesc::Read<Target>(counter), 1UL);
+    EXPECT_EQ(MwCASDesc::Read<Target>(addr), 0x102UL);
+
+    // the masked bits have been swapped, so the next retry fails
+    EXPECT_FALSE(desc.MwCAS());
+    EXPECT_EQ(MwCASDesc::Read<Target>(counter), 1UL);
+    EXPECT_EQ(MwCASDesc::Read<Target>(addr), 0x102UL);
+  }
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  Target target_fields_[kTargetFieldNum]{};
+};
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(  //
+    DeadlockFreeMwCASDescriptorFixture,
+    MaskedMwCASWithMultiThreadsPreservesUnmaskedBits)
+{
+  VerifyMaskedMwCAS(std::min<size_t>(kTestThreadNum, 4));
+}
+
+TEST_F(  //
+    DeadlockFreeMwCASDescriptorFixture,
+    DeltaMwCASWithMultiThreadsCorrectlyIncrementCounter)
+{
+  VerifyDeltaMwCAS(kTestThreadNum);
+}
+
+TEST_F(  //
+    DeadlockFreeMwCASDescriptorFixture,
+    DeltaOverflowingIntoMwCASFlagMakesMwCASFail)
+{
+  VerifyOverflowedDeltaMwCAS();
+}
+
+TEST_F(  //
+    DeadlockFreeMwCASDescriptorFixture,
+    MwCASWithUnsortedTargetsCorrectlyIncrementTargets)
+{
+  VerifyMwCASWithUnsortedTargets(kTestThreadNum);
+}
+
+TEST_F(  //
+    DeadlockFreeMwCASDescriptorFixture,
+    DuplicatedTargetsAreMergedOrRejected)
+{
+  VerifyDuplicatedTargets();
+}
+
+TEST_F(  //
+    DeadlockFreeMwCASDescriptorFixture,
+    RetriedMwCASAppliesOperandsOnlyOnce)
+{
+  VerifyRetriedMwCAS();
+}
+
+}  // namespace dbgroup::atomic::mwcas::test
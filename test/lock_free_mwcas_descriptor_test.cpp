@@ -0,0 +1,320 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include <dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp>
+
+// C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kLoopNum = 1e4;
+
+constexpr size_t kFieldNum = kMwCASCapacity * kTestThreadNum;
+
+constexpr size_t kBatchSize = 64;
+
+/*############################################################################*
+ * Utilities for recycle policies
+ *############################################################################*/
+
+struct Node {
+  uint64_t key{};
+};
+
+/// @brief The keys of released nodes.
+std::vector<uint64_t> released_keys{};  // NOLINT
+
+/// @brief A mutex for protecting released keys.
+std::mutex released_mtx{};  // NOLINT
+
+struct RecordingDeleter {
+  void
+  operator()(  //
+      Node* node) const
+  {
+    const std::lock_guard lock{released_mtx};
+    released_keys.emplace_back(node->key);
+    delete node;
+  }
+};
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+class LockFreeMwCASDescriptorFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using MwCASDesc = lock_free::MwCASDescriptor;
+  using Target = uint64_t;
+
+  /*##########################################################################*
+   * Setup/Teardown
+   *##########################################################################*/
+
+  static void
+  SetUpTestSuite()
+  {
+    dbgroup::thread::IDManager::SetMaxThreadNum(dbgroup::kMaxThreadCapacity);
+  }
+
+  void
+  SetUp() override
+  {
+    MwCASDesc::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    MwCASDesc::StopGC();
+  }
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  static void
+  VerifyMwCASBatch(  //
+      const size_t thread_num)
+  {
+    std::array<Target, kFieldNum> fields{};
+
+    auto add_targets = [&](MwCASDesc* desc, const std::vector<size_t>& targets) {
+      for (const auto idx : targets) {
+        const auto [cur_val, word] = MwCASDesc::Read<Target>(&(fields[idx]), kRelaxed);
+        desc->AddMwCASTarget(&(fields[idx]), word, cur_val + 1, kRelaxed);
+      }
+    };
+
+    auto f = [&](const size_t rand_seed) {
+      std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+      std::uniform_int_distribution<size_t> dist{0, kFieldNum - 1};
+      std::array<std::vector<size_t>, kBatchSize> operations{};
+      std::array<MwCASDesc*, kBatchSize> descs{};
+      std::array<bool, kBatchSize> results{};
+      for (size_t i = 0; i < kLoopNum; i += kBatchSize) {
+        // select MwCAS target fields randomly
+        for (auto&& targets : operations) {
+          targets.clear();
+          while (targets.size() < kMwCASCapacity) {
+            const auto idx = dist(rand_engine);
+            if (std::find(targets.begin(), targets.end(), idx) == targets.end()) {
+              targets.emplace_back(idx);
+            }
+          }
+          std::sort(targets.begin(), targets.end());
+        }
+
+        {
+          [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+          for (size_t j = 0; j < kBatchSize; ++j) {
+            descs[j] = MwCASDesc::GetDescriptor();
+            add_targets(descs[j], operations[j]);
+          }
+          MwCASDesc::MwCASBatch(descs.data(), results.data(), kBatchSize);
+        }
+
+        // retry failed operations one by one
+        for (size_t j = 0; j < kBatchSize; ++j) {
+          while (!results[j]) {
+            [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+            auto* const desc = MwCASDesc::GetDescriptor();
+            add_targets(desc, operations[j]);
+            results[j] = desc->MwCAS();
+          }
+        }
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, rand_engine());
+    }
+    for (auto&& t : threads) t.join();
+
+    // check the target fields are correctly incremented
+    size_t sum = 0;
+    for (auto&& field : fields) {
+      sum += MwCASDesc::Read<Target>(&field).first;
+    }
+    const auto op_num = (kLoopNum + kBatchSize - 1) / kBatchSize * kBatchSize;
+    EXPECT_EQ(op_num * thread_num * kMwCASCapacity, sum);
+  }
+
+  static void
+  VerifyMwCASWithOverflowedTargets(  //
+      const size_t thread_num)
+  {
+    constexpr size_t kTargetNum = MwCASDesc::kMaxTargetNum;
+    std::array<Target, kTargetNum> fields{};
+
+    auto f = [&]() {
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        while (true) {
+          [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+          auto* const desc = MwCASDesc::GetDescriptor();
+          for (auto&& field : fields) {
+            const auto [cur_val, word] = MwCASDesc::Read<Target>(&field, kRelaxed);
+            desc->AddMwCASTarget(&field, word, cur_val + 1, kRelaxed);
+          }
+          if (desc->MwCAS()) break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f);
+    }
+    for (auto&& t : threads) t.join();
+
+    for (auto&& field : fields) {
+      EXPECT_EQ(MwCASDesc::Read<Target>(&field).first, kLoopNum * thread_num);
+    }
+  }
+
+  static void
+  VerifyMwCASWithSameLineTargets(  //
+      const size_t thread_num)
+  {
+    constexpr size_t kTargetNum = kCacheLineSize / sizeof(Target);
+    alignas(kCacheLineSize) std::array<Target, 2 * kTargetNum> fields{};
+
+    // add targets in two cache lines alternately and in the reverse order
+    auto f = [&]() {
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        while (true) {
+          [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+          auto* const desc = MwCASDesc::GetDescriptor();
+          for (size_t j = kTargetNum; j > 0; --j) {
+            for (auto* addr : {&(fields[j - 1]), &(fields[kTargetNum + j - 1])}) {
+              const auto [cur_val, word] = MwCASDesc::Read<Target>(addr, kRelaxed);
+              desc->AddMwCASTarget(addr, word, cur_val + 1, kRelaxed);
+            }
+          }
+          if (desc->MwCAS()) break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f);
+    }
+    for (auto&& t : threads) t.join();
+
+    for (auto&& field : fields) {
+      EXPECT_EQ(MwCASDesc::Read<Target>(&field).first, kLoopNum * thread_num);
+    }
+  }
+
+  static void
+  VerifyRecyclePolicies()
+  {
+    std::array<Node*, 2> fields{new Node{1}, new Node{2}};
+    released_keys.clear();
+
+    std::thread{[&] {
+      [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+
+      // succeeded MwCAS reclaims the old pointers
+      const auto [node, stale] = MwCASDesc::Read<Node*>(&(fields[0]));
+      auto* desc = MwCASDesc::GetDescriptor();
+      for (auto&& field : fields) {
+        const auto [cur, expected] = MwCASDesc::Read<Node*>(&field);
+        desc->AddMwCASTarget<Node, RecordingDeleter>(  //
+            &field, expected, new Node{cur->key + 10}, MwCASDesc::kRecycleAlways);
+      }
+      EXPECT_EQ(desc->RecycleSize(), fields.size());
+      EXPECT_TRUE(desc->MwCAS());
+
+      // failed MwCAS reclaims the new pointer
+      desc = MwCASDesc::GetDescriptor();
+      desc->AddMwCASTarget<Node, RecordingDeleter>(  //
+          &(fields[0]), stale, new Node{node->key + 20}, MwCASDesc::kRecycleNewOnFailure);
+      EXPECT_FALSE(desc->MwCAS());
+    }}.join();
+
+    // the retired descriptors release the pointers when they are reused
+    MwCASDesc::StopGC();
+    std::sort(released_keys.begin(), released_keys.end());
+    EXPECT_EQ(released_keys, (std::vector<uint64_t>{1, 2, 21}));
+    MwCASDesc::StartGC();
+
+    for (auto* node : fields) {
+      delete MwCASDesc::Read<Node*>(&node).first;  // NOLINT
+    }
+  }
+};
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(  //
+    LockFreeMwCASDescriptorFixture,
+    MwCASBatchWithMultiThreadsCorrectlyIncrementTargets)
+{
+  VerifyMwCASBatch(kTestThreadNum);
+}
+
+TEST_F(  //
+    LockFreeMwCASDescriptorFixture,
+    MwCASWithOverflowedTargetsCorrectlyIncrementTargets)
+{
+  VerifyMwCASWithOverflowedTargets(kTestThreadNum);
+}
+
+TEST_F(  //
+    LockFreeMwCASDescriptorFixture,
+    MwCASWithSameLineTargetsCorrectlyIncrementTargets)
+{
+  VerifyMwCASWithSameLineTargets(kTestThreadNum);
+}
+
+TEST_F(  //
+    LockFreeMwCASDescriptorFixture,
+    RecyclePoliciesReclaimSelectedPointers)
+{
+  VerifyRecyclePolicies();
+}
+
+}  // namespace dbgroup::atomic::mwcas::test
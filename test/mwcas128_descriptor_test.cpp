@@ -0,0 +1,165 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include <dbgroup/atomic/mwcas/lock_free/mwcas128_descriptor.hpp>
+
+// C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kLoopNum = 1e5;
+
+constexpr size_t kFieldNum = kMwCASCapacity * kTestThreadNum;
+
+/// @brief An initial value using all the 64 bits of payloads.
+constexpr uint64_t kInitVal = ~0UL << 8UL;
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+class MwCAS128DescriptorFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using MwCASDesc = lock_free::MwCAS128Descriptor;
+  using Word = MwCASDesc::Word;
+
+  /*##########################################################################*
+   * Setup/Teardown
+   *##########################################################################*/
+
+  static void
+  SetUpTestSuite()
+  {
+    dbgroup::thread::IDManager::SetMaxThreadNum(dbgroup::kMaxThreadCapacity);
+  }
+
+  void
+  SetUp() override
+  {
+    for (auto&& field : fields_) {
+      field = Word{kInitVal, 0};
+    }
+    MwCASDesc::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    MwCASDesc::StopGC();
+  }
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  void
+  VerifyMwCAS(  //
+      const size_t thread_num)
+  {
+    auto f = [&](const size_t rand_seed) {
+      std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+      std::uniform_int_distribution<size_t> dist{0, kFieldNum - 1};
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        // select MwCAS target fields randomly
+        std::vector<size_t> targets{};
+        while (targets.size() < kMwCASCapacity) {
+          const auto idx = dist(rand_engine);
+          if (std::find(targets.begin(), targets.end(), idx) == targets.end()) {
+            targets.emplace_back(idx);
+          }
+        }
+
+        while (true) {
+          [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+          auto* const desc = MwCASDesc::GetDescriptor();
+          for (auto idx : targets) {
+            auto* const addr = &(fields_[idx]);
+            const auto [cur_val, word] = MwCASDesc::Read<uint64_t>(addr, kRelaxed);
+            desc->AddMwCASTarget(addr, word, cur_val + 1, kRelaxed);
+          }
+          if (desc->MwCAS()) break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, rand_engine());
+    }
+    for (auto&& t : threads) t.join();
+
+    // check the target fields are correctly incremented
+    size_t sum = 0;
+    size_t ver_sum = 0;
+    for (auto&& field : fields_) {
+      const auto [val, word] = MwCASDesc::Read<uint64_t>(&field);
+      sum += val - kInitVal;
+      ver_sum += word.meta;
+    }
+    EXPECT_EQ(kLoopNum * thread_num * kMwCASCapacity, sum);
+    EXPECT_EQ(sum, ver_sum);
+  }
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  std::array<Word, kFieldNum> fields_{};
+};
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(  //
+    MwCAS128DescriptorFixture,
+    MwCASWithSingleThreadCorrectlyIncrementTargets)
+{
+  VerifyMwCAS(1);
+}
+
+TEST_F(  //
+    MwCAS128DescriptorFixture,
+    MwCASWithMultiThreadsCorrectlyIncrementTargets)
+{
+  VerifyMwCAS(kTestThreadNum);
+}
+
+}  // namespace dbgroup::atomic::mwcas::test
@@ -15,12 +15,16 @@
  */
 
 // the corresponding headers
+#include <dbgroup/atomic/mwcas/adaptive_mwcas_descriptor.hpp>
 #include <dbgroup/atomic/mwcas/deadlock_free/mwcas_descriptor.hpp>
+#include <dbgroup/atomic/mwcas/exclusive_guard.hpp>
 #include <dbgroup/atomic/mwcas/lock_free/aopt_descriptor.hpp>
 #include <dbgroup/atomic/mwcas/lock_free/casn_descriptor.hpp>
 #include <dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp>
 
 // C++ standard libraries
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <mutex>
@@ -50,6 +54,7 @@ using DLFMwCAS = deadlock_free::MwCASDescriptor;
 using LFMwCAS = lock_free::MwCASDescriptor;
 using CASN = lock_free::CASNDescriptor;
 using AOPT = lock_free::AOPTDescriptor;
+using Adaptive = AdaptiveMwCASDescriptor;
 
 /*############################################################################*
  * Internal constants
@@ -101,7 +106,7 @@ class MwCASDescriptorFixture : public ::testing::Test
     }
 
     if constexpr (std::is_same_v<MwCASDesc, AOPT> || std::is_same_v<MwCASDesc, CASN>
-                  || std::is_same_v<MwCASDesc, LFMwCAS>) {
+                  || std::is_same_v<MwCASDesc, LFMwCAS> || std::is_same_v<MwCASDesc, Adaptive>) {
       MwCASDesc::StartGC();
     }
   }
@@ -110,7 +115,7 @@ class MwCASDescriptorFixture : public ::testing::Test
   TearDown() override
   {
     if constexpr (std::is_same_v<MwCASDesc, AOPT> || std::is_same_v<MwCASDesc, CASN>
-                  || std::is_same_v<MwCASDesc, LFMwCAS>) {
+                  || std::is_same_v<MwCASDesc, LFMwCAS> || std::is_same_v<MwCASDesc, Adaptive>) {
       MwCASDesc::StopGC();
     }
   }
@@ -126,6 +131,57 @@ class MwCASDescriptorFixture : public ::testing::Test
     RunMwCAS(thread_num);
 
     // check the target fields are correctly incremented
+    EXPECT_EQ(kOpsNum * thread_num * kMwCASCapacity, SumTargetFields());
+  }
+
+  void
+  VerifyExclusiveMwCAS(  //
+      const size_t thread_num)
+  {
+    {  // load target fields without embedding descriptors
+      [[maybe_unused]] const ExclusiveGuard guard{};
+      MwCASRandomly(kRandomSeed);
+    }
+    RunMwCAS(thread_num);
+
+    // check the target fields are correctly incremented
+    EXPECT_EQ(kOpsNum * (thread_num + 1) * kMwCASCapacity, SumTargetFields());
+  }
+
+  void
+  VerifyReadBatch()
+  {
+    RunMwCAS(1);
+
+    // check batched reads return the same values as individual ones
+    std::array<void*, kTargetFieldNum> addrs{};
+    for (size_t i = 0; i < kTargetFieldNum; ++i) {
+      addrs[i] = &(target_fields_[i]);
+    }
+    if constexpr (std::is_same_v<MwCASDesc, LFMwCAS>) {
+      std::array<std::pair<Target, Target>, kTargetFieldNum> vals{};
+      MwCASDesc::template ReadBatch<Target>(addrs.data(), vals.data(), kTargetFieldNum);
+      for (size_t i = 0; i < kTargetFieldNum; ++i) {
+        EXPECT_EQ(MwCASDesc::template Read<Target>(addrs[i]), vals[i]);
+      }
+    } else {
+      std::array<Target, kTargetFieldNum> vals{};
+      MwCASDesc::template ReadBatch<Target>(addrs.data(), vals.data(), kTargetFieldNum);
+      for (size_t i = 0; i < kTargetFieldNum; ++i) {
+        EXPECT_EQ(MwCASDesc::template Read<Target>(addrs[i]), vals[i]);
+      }
+    }
+  }
+
+ private:
+  /*##########################################################################*
+   * Internal utility functions
+   *##########################################################################*/
+
+  auto
+  SumTargetFields()  //
+      -> size_t
+  {
     size_t sum = 0;
     for (auto& target : target_fields_) {
       if constexpr (std::is_same_v<MwCASDesc, LFMwCAS>) {
@@ -134,15 +190,9 @@ class MwCASDescriptorFixture : public ::testing::Test
         sum += MwCASDesc::template Read<Target>(&target);
       }
     }
-
-    EXPECT_EQ(kOpsNum * thread_num * kMwCASCapacity, sum);
+    return sum;
   }
 
- private:
-  /*##########################################################################*
-   * Internal utility functions
-   *##########################################################################*/
-
   void
   MwCAS(  //
       const MwCASTargets& targets)
@@ -158,6 +208,18 @@ class MwCASDescriptorFixture : public ::testing::Test
         }
         if (desc.MwCAS()) return;
       }
+    } else if constexpr (std::is_same_v<MwCASDesc, Adaptive>) {
+      while (true) {
+        [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
+        MwCASDesc desc{};
+        for (auto idx : targets) {
+          auto* const addr = &(target_fields_[idx]);
+          const auto cur_val = MwCASDesc::template Read<Target>(addr, kRelaxed);
+          const auto new_val = cur_val + 1;
+          desc.AddMwCASTarget(addr, cur_val, new_val, kRelaxed);
+        }
+        if (desc.MwCAS()) return;
+      }
     } else if constexpr (std::is_same_v<MwCASDesc, LFMwCAS>) {
       while (true) {
         [[maybe_unused]] const auto& guard = MwCASDesc::CreateEpochGuard();
@@ -265,7 +327,7 @@ class MwCASDescriptorFixture : public ::testing::Test
  * Preparation for typed testing
  *############################################################################*/
 
-using MwCASDescriptors = ::testing::Types<DLFMwCAS, LFMwCAS, AOPT, CASN>;
+using MwCASDescriptors = ::testing::Types<DLFMwCAS, LFMwCAS, AOPT, CASN, Adaptive>;
 TYPED_TEST_SUITE(MwCASDescriptorFixture, MwCASDescriptors);
 
 /*############################################################################*
@@ -286,4 +348,18 @@ TYPED_TEST(  //
   TestFixture::VerifyMwCAS(kTestThreadNum);
 }
 
+TYPED_TEST(  //
+    MwCASDescriptorFixture,
+    ExclusiveMwCASBeforeMultiThreadsCorrectlyIncrementTargets)
+{
+  TestFixture::VerifyExclusiveMwCAS(kTestThreadNum);
+}
+
+TYPED_TEST(  //
+    MwCASDescriptorFixture,
+    ReadBatchReturnsSameValuesAsRead)
+{
+  TestFixture::VerifyReadBatch();
+}
+
 }  // namespace dbgroup::atomic::mwcas::test
@@ -0,0 +1,461 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include <dbgroup/atomic/mwcas/persistent/mwcas_descriptor.hpp>
+
+// C++ standard libraries
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// system libraries
+#include <csignal>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kLoopNum = 1e3;
+
+constexpr size_t kFieldNum = kMwCASCapacity * kTestThreadNum;
+
+constexpr size_t kRegionSize = 1UL << 20UL;
+
+constexpr size_t kCrashNum = 5;
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+class PersistentMwCASDescriptorFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using MwCASDesc = persistent::MwCASDescriptor;
+
+  /*##########################################################################*
+   * Setup/Teardown
+   *##########################################################################*/
+
+  void
+  SetUp() override
+  {
+    // use tmpfs if possible because msync is called for each persisted word
+    const std::filesystem::path shm{"/dev/shm"};
+    const auto dir = std::filesystem::is_directory(shm)  //
+                         ? shm
+                         : std::filesystem::temp_directory_path();
+    path_ = dir / ("dbgroup_pmwcas_test_" + std::to_string(::getpid()) + ".dat");
+    shm_name_ = "/dbgroup_pmwcas_test_" + std::to_string(::getpid());
+    std::filesystem::remove(path_);
+    ::shm_unlink(shm_name_.c_str());
+    ASSERT_TRUE(MwCASDesc::Open(path_, kRegionSize));
+  }
+
+  void
+  TearDown() override
+  {
+    MwCASDesc::Close();
+    std::filesystem::remove(path_);
+    ::shm_unlink(shm_name_.c_str());
+  }
+
+  /*##########################################################################*
+   * Utility functions
+   *##########################################################################*/
+
+  static auto
+  GetFields()  //
+      -> uint64_t*
+  {
+    return static_cast<uint64_t*>(MwCASDesc::GetRoot());
+  }
+
+  static auto
+  CreateRandomTargets(  //
+      std::mt19937_64& rand_engine)  //
+      -> std::vector<size_t>
+  {
+    std::uniform_int_distribution<size_t> dist{0, kFieldNum - 1};
+    std::vector<size_t> targets{};
+    while (targets.size() < kMwCASCapacity) {
+      const auto idx = dist(rand_engine);
+      if (std::find(targets.begin(), targets.end(), idx) == targets.end()) {
+        targets.emplace_back(idx);
+      }
+    }
+    std::sort(targets.begin(), targets.end());
+    return targets;
+  }
+
+  static void
+  MwCAS(  //
+      const std::vector<size_t>& targets)
+  {
+    auto* const fields = GetFields();
+    while (true) {
+      auto* const desc = MwCASDesc::GetDescriptor();
+      for (auto idx : targets) {
+        auto* const addr = &(fields[idx]);
+        const auto cur_val = MwCASDesc::Read<uint64_t>(addr, kRelaxed);
+        desc->AddMwCASTarget(addr, cur_val, cur_val + 1, kRelaxed);
+      }
+      if (desc->MwCAS()) return;
+    }
+  }
+
+  static auto
+  SumFields(  //
+      const size_t num)  //
+      -> size_t
+  {
+    size_t sum = 0;
+    for (size_t i = 0; i < num; ++i) {
+      sum += MwCASDesc::Read<uint64_t>(&(GetFields()[i]));
+    }
+    return sum;
+  }
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  void
+  VerifyMwCAS(  //
+      const size_t thread_num)
+  {
+    auto f = [&](const size_t rand_seed) {
+      std::mt19937_64 rand_engine{rand_seed};  // NOLINT
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        MwCAS(CreateRandomTargets(rand_engine));
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, rand_engine());
+    }
+    for (auto&& t : threads) t.join();
+
+    // check the target fields are incremented durably
+    MwCASDesc::Close();
+    ASSERT_TRUE(MwCASDesc::Open(path_, kRegionSize));
+    EXPECT_EQ(kLoopNum * thread_num * kMwCASCapacity, SumFields(kFieldNum));
+  }
+
+  void
+  VerifyRecovery()
+  {
+    // all the MwCAS operations increment the same fields
+    std::vector<size_t> targets{};
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      targets.emplace_back(i);
+    }
+
+    uint64_t prev_val = 0;
+    for (size_t i = 0; i < kCrashNum; ++i) {
+      MwCASDesc::Close();
+      int fds[2]{};
+      ASSERT_EQ(::pipe(fds), 0);
+
+      const auto pid = ::fork();
+      ASSERT_GE(pid, 0);
+      if (pid == 0) {
+        // a child process runs MwCAS until it is killed
+        if (!MwCASDesc::Open(path_, kRegionSize)) ::_exit(1);
+        auto f = [&] {
+          while (true) {
+            MwCAS(targets);
+          }
+        };
+        std::vector<std::thread> threads{};
+        for (size_t j = 0; j < kTestThreadNum; ++j) {
+          threads.emplace_back(f);
+        }
+        while (MwCASDesc::Read<uint64_t>(GetFields()) < prev_val + kLoopNum) {
+          std::this_thread::sleep_for(std::chrono::microseconds{100});
+        }
+        [[maybe_unused]] const auto written = ::write(fds[1], "r", 1);
+        for (auto&& t : threads) t.join();
+        ::_exit(0);
+      }
+
+      // simulate a crash while the child is performing MwCAS
+      char buf{};
+      ASSERT_EQ(::read(fds[0], &buf, 1), 1);
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      ::kill(pid, SIGKILL);
+      ::waitpid(pid, nullptr, 0);
+      ::close(fds[0]);
+      ::close(fds[1]);
+
+      // incomplete MwCAS operations must be rolled back or forward
+      ASSERT_TRUE(MwCASDesc::Open(path_, kRegionSize));
+      const auto val = MwCASDesc::Read<uint64_t>(GetFields());
+      EXPECT_GE(val, prev_val + kLoopNum);
+      for (size_t j = 0; j < kMwCASCapacity; ++j) {
+        const auto word = std::atomic_ref<uint64_t>{GetFields()[j]}.load();
+        EXPECT_EQ(word & kMwCASFlag, 0UL);
+        EXPECT_EQ(MwCASDesc::Read<uint64_t>(&(GetFields()[j])), val);
+      }
+      prev_val = val;
+    }
+
+    // the recovered region can be used as usual
+    MwCAS(targets);
+    EXPECT_EQ(SumFields(kMwCASCapacity), (prev_val + 1) * kMwCASCapacity);
+  }
+
+  void
+  VerifyMwCASOverSharedMemory(  //
+      const size_t process_num)
+  {
+    MwCASDesc::Close();
+    ASSERT_TRUE(MwCASDesc::Attach(shm_name_, kRegionSize));
+
+    std::vector<pid_t> pids{};
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < process_num; ++i) {
+      const auto rand_seed = rand_engine();
+      const auto pid = ::fork();
+      ASSERT_GE(pid, 0);
+      if (pid == 0) {
+        // remap the shared memory, which may be placed at another address
+        MwCASDesc::Close();
+        if (!MwCASDesc::Attach(shm_name_, kRegionSize)) ::_exit(1);
+        std::mt19937_64 child_engine{rand_seed};  // NOLINT
+        for (size_t j = 0; j < kLoopNum; ++j) {
+          MwCAS(CreateRandomTargets(child_engine));
+        }
+        ::_exit(0);
+      }
+      pids.emplace_back(pid);
+    }
+    for (const auto pid : pids) {
+      int status{};
+      ::waitpid(pid, &status, 0);
+      EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    EXPECT_EQ(kLoopNum * process_num * kMwCASCapacity, SumFields(kFieldNum));
+  }
+
+  void
+  VerifyHelpingAbandonedDescriptors()
+  {
+    MwCASDesc::Close();
+    ASSERT_TRUE(MwCASDesc::Attach(shm_name_, kRegionSize));
+
+    // all the MwCAS operations increment the same fields
+    std::vector<size_t> targets{};
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      targets.emplace_back(i);
+    }
+
+    uint64_t prev_val = 0;
+    for (size_t i = 0; i < kCrashNum; ++i) {
+      const auto pid = ::fork();
+      ASSERT_GE(pid, 0);
+      if (pid == 0) {
+        while (true) {
+          MwCAS(targets);
+        }
+      }
+
+      // kill the child while it is performing MwCAS
+      while (MwCASDesc::Read<uint64_t>(GetFields()) < prev_val + kLoopNum) {
+        std::this_thread::sleep_for(std::chrono::microseconds{100});
+      }
+      ::kill(pid, SIGKILL);
+      ::waitpid(pid, nullptr, 0);
+
+      // descriptors left by the child must be completed by this process
+      for (size_t j = 0; j < kLoopNum; ++j) {
+        MwCAS(targets);
+      }
+      const auto val = MwCASDesc::Read<uint64_t>(GetFields());
+      for (size_t j = 0; j < kMwCASCapacity; ++j) {
+        EXPECT_EQ(MwCASDesc::Read<uint64_t>(&(GetFields()[j])), val);
+      }
+      prev_val = val;
+    }
+  }
+
+  void
+  VerifyHelpingStoppedDescriptors()
+  {
+    MwCASDesc::Close();
+    ASSERT_TRUE(MwCASDesc::Attach(shm_name_, kRegionSize));
+
+    // all the MwCAS operations increment the same fields
+    std::vector<size_t> targets{};
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      targets.emplace_back(i);
+    }
+
+    uint64_t prev_val = 0;
+    for (size_t i = 0; i < kCrashNum; ++i) {
+      const auto pid = ::fork();
+      ASSERT_GE(pid, 0);
+      if (pid == 0) {
+        // use multiple threads so that some of them are stopped in MwCAS
+        auto f = [&] {
+          while (true) {
+            MwCAS(targets);
+          }
+        };
+        std::vector<std::thread> threads{};
+        for (size_t j = 0; j < kTestThreadNum; ++j) {
+          threads.emplace_back(f);
+        }
+        for (auto&& t : threads) t.join();
+      }
+
+      // stop the child while it is performing MwCAS
+      while (MwCASDesc::Read<uint64_t>(GetFields()) < prev_val + kLoopNum) {
+        std::this_thread::sleep_for(std::chrono::microseconds{100});
+      }
+      ::kill(pid, SIGSTOP);
+
+      // descriptors of the stopped child must not block this process
+      for (size_t j = 0; j < kLoopNum; ++j) {
+        MwCAS(targets);
+      }
+      const auto val = MwCASDesc::Read<uint64_t>(GetFields());
+      for (size_t j = 0; j < kMwCASCapacity; ++j) {
+        EXPECT_EQ(MwCASDesc::Read<uint64_t>(&(GetFields()[j])), val);
+      }
+      ::kill(pid, SIGKILL);
+      ::waitpid(pid, nullptr, 0);
+      prev_val = MwCASDesc::Read<uint64_t>(GetFields());
+    }
+  }
+
+  void
+  VerifyAttachAfterCreatorCrash()
+  {
+    MwCASDesc::Close();
+
+    // a creator dies after sizing the shared memory but before initializing it
+    const auto pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      const auto fd = ::shm_open(shm_name_.c_str(), O_RDWR | O_CREAT, 0600);  // NOLINT
+      if (fd < 0 || ::flock(fd, LOCK_EX) != 0) ::_exit(1);
+      if (::ftruncate(fd, static_cast<off_t>(kRegionSize)) != 0) ::_exit(1);
+      ::_exit(0);
+    }
+    int status{};
+    ::waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // the next process must initialize the shared memory again
+    ASSERT_TRUE(MwCASDesc::Attach(shm_name_, kRegionSize));
+    std::mt19937_64 rand_engine{kRandomSeed};  // NOLINT
+    for (size_t i = 0; i < kLoopNum; ++i) {
+      MwCAS(CreateRandomTargets(rand_engine));
+    }
+    EXPECT_EQ(kLoopNum * kMwCASCapacity, SumFields(kFieldNum));
+  }
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  std::filesystem::path path_{};
+
+  std::string shm_name_{};
+};
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(  //
+    PersistentMwCASDescriptorFixture,
+    MwCASWithSingleThreadDurablyIncrementTargets)
+{
+  VerifyMwCAS(1);
+}
+
+TEST_F(  //
+    PersistentMwCASDescriptorFixture,
+    MwCASWithMultiThreadsDurablyIncrementTargets)
+{
+  VerifyMwCAS(kTestThreadNum);
+}
+
+TEST_F(  //
+    PersistentMwCASDescriptorFixture,
+    OpenAfterCrashesRecoversIncompleteMwCAS)
+{
+  VerifyRecovery();
+}
+
+TEST_F(  //
+    PersistentMwCASDescriptorFixture,
+    MwCASFromMultiProcessesCorrectlyIncrementTargets)
+{
+  VerifyMwCASOverSharedMemory(kTestThreadNum);
+}
+
+TEST_F(  //
+    PersistentMwCASDescriptorFixture,
+    MwCASAfterOwnerCrashesCompletesAbandonedDescriptors)
+{
+  VerifyHelpingAbandonedDescriptors();
+}
+
+TEST_F(  //
+    PersistentMwCASDescriptorFixture,
+    MwCASWhileOwnerIsStoppedCompletesStalledDescriptors)
+{
+  VerifyHelpingStoppedDescriptors();
+}
+
+TEST_F(  //
+    PersistentMwCASDescriptorFixture,
+    AttachAfterCreatorCrashesInitializesSharedMemory)
+{
+  VerifyAttachAfterCreatorCrash();
+}
+
+}  // namespace dbgroup::atomic::mwcas::test
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include <dbgroup/atomic/mwcas/lock_free/mwcas_descriptor.hpp>
+#include <dbgroup/atomic/mwcas/lock_free/rdcss_descriptor.hpp>
+
+// C++ standard libraries
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kLoopNum = 1e5;
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+class RDCSSDescriptorFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using RDCSSDesc = lock_free::RDCSSDescriptor;
+  using MwCASDesc = lock_free::MwCASDescriptor;
+
+  /*##########################################################################*
+   * Setup/Teardown
+   *##########################################################################*/
+
+  static void
+  SetUpTestSuite()
+  {
+    dbgroup::thread::IDManager::SetMaxThreadNum(dbgroup::kMaxThreadCapacity);
+  }
+
+  void
+  SetUp() override
+  {
+    control_ = 0;
+    target_ = 0;
+    shared_.fill(0);
+    RDCSSDesc::StartGC();
+    MwCASDesc::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    MwCASDesc::StopGC();
+    RDCSSDesc::StopGC();
+  }
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  void
+  VerifyRDCSS(  //
+      const size_t thread_num,
+      const bool close_control)
+  {
+    std::atomic_size_t succeeded_num{0};
+    auto f = [&]() {
+      size_t cnt = 0;
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        while (true) {
+          [[maybe_unused]] const auto& guard = RDCSSDesc::CreateEpochGuard();
+          const auto cur_val = RDCSSDesc::Read<uint64_t>(&target_, kRelaxed);
+          if (RDCSSDesc::RDCSS(&control_, 0UL, &target_, cur_val, cur_val + 1, kRelaxed)) {
+            ++cnt;
+            break;
+          }
+          if (control_.load(kRelaxed) != 0) break;
+        }
+      }
+      succeeded_num += cnt;
+    };
+
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f);
+    }
+    if (close_control) {
+      control_ = 1;
+    }
+    for (auto&& t : threads) t.join();
+
+    // check the target field is incremented only by succeeded operations
+    const auto val = RDCSSDesc::Read<uint64_t>(&target_);
+    EXPECT_EQ(val, succeeded_num.load());
+    if (!close_control) {
+      EXPECT_EQ(val, kLoopNum * thread_num);
+    }
+  }
+
+  void
+  VerifyRDCSSWithMwCAS(  //
+      const size_t thread_num)
+  {
+    auto* const control = &(shared_[0]);
+    auto* const target = &(shared_[1]);
+
+    // RDCSS increments the target while MwCAS increments both the words
+    std::atomic_size_t rdcss_num{0};
+    auto f = [&](const bool use_mwcas) {
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        while (true) {
+          [[maybe_unused]] const auto& guard = RDCSSDesc::CreateEpochGuard();
+          [[maybe_unused]] const auto& mwcas_guard = MwCASDesc::CreateEpochGuard();
+          const auto [ctrl_val, ctrl_word] = MwCASDesc::Read<uint64_t>(control, kRelaxed);
+          const auto [cur_val, word] = MwCASDesc::Read<uint64_t>(target, kRelaxed);
+          if (use_mwcas) {
+            auto* desc = MwCASDesc::GetDescriptor();
+            desc->AddMwCASTarget(control, ctrl_word, ctrl_val + 1, kRelaxed);
+            desc->AddMwCASTarget(target, word, cur_val + 1, kRelaxed);
+            if (desc->MwCAS()) break;
+          } else if (RDCSSDesc::RDCSS(control, ctrl_word, target, word, word + 1, kRelaxed)) {
+            ++rdcss_num;
+            break;
+          }
+        }
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f, i % 2 == 0);
+    }
+    for (auto&& t : threads) t.join();
+
+    // check both the words are incremented exactly once by each operation
+    const auto mwcas_num = kLoopNum * thread_num - rdcss_num.load();
+    EXPECT_EQ(MwCASDesc::Read<uint64_t>(control).first, mwcas_num);
+    EXPECT_EQ(RDCSSDesc::Read<uint64_t>(target) & ((1UL << kValueBitNum) - 1UL),
+              kLoopNum * thread_num);
+  }
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  std::atomic_uint64_t control_{0};
+
+  uint64_t target_{0};
+
+  std::array<uint64_t, 2> shared_{};
+};
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(  //
+    RDCSSDescriptorFixture,
+    RDCSSWithMultiThreadsCorrectlyIncrementTarget)
+{
+  VerifyRDCSS(kTestThreadNum, false);
+}
+
+TEST_F(  //
+    RDCSSDescriptorFixture,
+    RDCSSWithChangedControlWordNeverSwapsTarget)
+{
+  VerifyRDCSS(kTestThreadNum, true);
+}
+
+TEST_F(  //
+    RDCSSDescriptorFixture,
+    RDCSSAndMwCASOnSharedWordsCorrectlyIncrementTargets)
+{
+  VerifyRDCSSWithMwCAS(kTestThreadNum);
+}
+
+}  // namespace dbgroup::atomic::mwcas::test
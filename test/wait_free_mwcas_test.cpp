@@ -0,0 +1,141 @@
+/*
+ * Copyright 2025 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include <dbgroup/atomic/mwcas/lock_free/wait_free_mwcas.hpp>
+
+// C++ standard libraries
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// external libraries
+#include <gtest/gtest.h>
+
+// local sources
+#include "common.hpp"
+
+namespace dbgroup::atomic::mwcas::test
+{
+/*############################################################################*
+ * Internal constants
+ *############################################################################*/
+
+constexpr size_t kLoopNum = 1e5;
+
+/*############################################################################*
+ * Fixture definitions
+ *############################################################################*/
+
+class WaitFreeMwCASFixture : public ::testing::Test
+{
+ protected:
+  /*##########################################################################*
+   * Type aliases
+   *##########################################################################*/
+
+  using MwCASDesc = lock_free::MwCASDescriptor;
+  using WaitFreeMwCAS = lock_free::WaitFreeMwCAS;
+
+  /*##########################################################################*
+   * Setup/Teardown
+   *##########################################################################*/
+
+  static void
+  SetUpTestSuite()
+  {
+    dbgroup::thread::IDManager::SetMaxThreadNum(dbgroup::kMaxThreadCapacity);
+  }
+
+  void
+  SetUp() override
+  {
+    fields_.fill(0);
+    MwCASDesc::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    MwCASDesc::StopGC();
+  }
+
+  /*##########################################################################*
+   * Functions for verification
+   *##########################################################################*/
+
+  void
+  VerifyExecute(  //
+      const size_t thread_num,
+      const size_t abort_interval)
+  {
+    // all the threads increment the same fields to cause heavy conflicts
+    auto f = [&]() {
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        const auto abort = (abort_interval > 0 && i % abort_interval == 0);
+        const auto succeeded = WaitFreeMwCAS::Execute([&](MwCASDesc* desc) {
+          if (abort) return false;
+          for (auto&& field : fields_) {
+            const auto [cur_val, word] = MwCASDesc::Read<uint64_t>(&field, kRelaxed);
+            desc->AddMwCASTarget(&field, word, cur_val + 1, kRelaxed);
+          }
+          return true;
+        });
+        EXPECT_NE(succeeded, abort);
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(f);
+    }
+    for (auto&& t : threads) t.join();
+
+    // check the fields are incremented exactly once by each operation
+    const auto aborted_num = (abort_interval > 0) ? (kLoopNum - 1) / abort_interval + 1 : 0;
+    for (auto&& field : fields_) {
+      EXPECT_EQ(MwCASDesc::Read<uint64_t>(&field).first, (kLoopNum - aborted_num) * thread_num);
+    }
+  }
+
+  /*##########################################################################*
+   * Internal member variables
+   *##########################################################################*/
+
+  std::array<uint64_t, kMwCASCapacity> fields_{};
+};
+
+/*############################################################################*
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(  //
+    WaitFreeMwCASFixture,
+    ExecuteWithMultiThreadsCorrectlyIncrementTargets)
+{
+  VerifyExecute(kTestThreadNum, 0);
+}
+
+TEST_F(  //
+    WaitFreeMwCASFixture,
+    ExecuteWithAbortedOperationsNeverIncrementTargets)
+{
+  VerifyExecute(kTestThreadNum, 10);
+}
+
+}  // namespace dbgroup::atomic::mwcas::test